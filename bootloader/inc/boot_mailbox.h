@@ -0,0 +1,135 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef BOOT_MAILBOX_H
+#define BOOT_MAILBOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief Boot mailbox (application to bootloader requests)
+ * 
+ * Versioned structure at the top of RAM (BOOT_MAILBOX_ADDR, directly below
+ * the legacy BOOTLOADER_MAGIC_ADDR word), guarded by a CRC32 over all
+ * fields before it. RAM keeps its content over a system reset, so the
+ * application sets an action and resets, and the bootloader consumes it on
+ * the next boot. A mailbox with a wrong magic, version, size or CRC (e.g.
+ * after power-on) is reinitialized with zero counters.
+ * 
+ * On every boot the bootloader increments boot_count, moves the requested
+ * action to last_action, clears action and records how the application
+ * was started in last_result before the jump.
+ * 
+ * Must match test-firmwares/template/bootloader_mailbox.h.
+ */
+typedef struct {
+    uint32_t magic;         /* BOOT_MAILBOX_MAGIC */
+    uint16_t version;       /* BOOT_MAILBOX_VERSION */
+    uint16_t size;          /* sizeof(boot_mailbox_t) */
+    uint16_t action;        /* Requested action (MAILBOX_ACTION_*), cleared by the bootloader */
+    uint16_t last_action;   /* Action handled on the last boot */
+    uint32_t arg;           /* Action argument */
+    uint32_t boot_count;    /* Boots since the mailbox was initialized */
+    uint32_t last_result;   /* How the application was started (MAILBOX_RESULT_*) */
+    uint32_t crc;           /* CRC32 of the fields above */
+} boot_mailbox_t;
+
+#define BOOT_MAILBOX_MAGIC      0xB0074B0C
+#define BOOT_MAILBOX_VERSION    1
+
+/**
+ * @brief Requested actions (boot_mailbox_t.action)
+ * 
+ * MAILBOX_ACTION_DFU:          Enter DFU mode. arg = timeout in ms,
+ *                              0 = BOOTLOADER_TIMEOUT_MS, MAILBOX_TIMEOUT_NONE
+ *                              = stay until a download completes.
+ * MAILBOX_ACTION_BOOT_SLOT:    Boot the other application slot. This
+ *                              bootloader has a single slot, the request is
+ *                              answered with MAILBOX_RESULT_UNSUPPORTED.
+ * MAILBOX_ACTION_SKIP_CHECK:   Skip the image CRC32/digest check once.
+ *                              arg = image CRC32 (app_header_t.crc32) the
+ *                              application has just verified. Header checks
+ *                              still run. Ignored with USE_IMAGE_SIGNATURE.
+ * MAILBOX_ACTION_DATA_UPDATE:  Enter DFU mode for a data partition update.
+ *                              arg = image CRC32 as for MAILBOX_ACTION_SKIP_CHECK.
+ *                              The application is started again without the
+ *                              image check, unless the application partition
+ *                              was written in the session.
+ */
+#define MAILBOX_ACTION_NONE         0
+#define MAILBOX_ACTION_DFU          1
+#define MAILBOX_ACTION_BOOT_SLOT    2
+#define MAILBOX_ACTION_SKIP_CHECK   3
+#define MAILBOX_ACTION_DATA_UPDATE  4
+
+#define MAILBOX_TIMEOUT_NONE        0xFFFFFFFF
+
+/**
+ * @brief How the application was started (boot_mailbox_t.last_result)
+ */
+#define MAILBOX_RESULT_NONE         0   /* No jump recorded yet */
+#define MAILBOX_RESULT_VALIDATED    1   /* Full image check passed */
+#define MAILBOX_RESULT_TRUSTED      2   /* Image check skipped on request */
+#define MAILBOX_RESULT_UNSUPPORTED  3   /* Action not supported, full image check */
+
+/**
+ * @brief Load mailbox and consume the requested action
+ * 
+ * Called once per boot, before the entry conditions are checked.
+ * Reinitializes an invalid mailbox, increments boot_count and clears the
+ * action (kept for mailbox_action()/mailbox_arg() until the next reset).
+ */
+void mailbox_load(void);
+
+/**
+ * @brief Action requested for this boot (MAILBOX_ACTION_*)
+ */
+uint16_t mailbox_action(void);
+
+/**
+ * @brief Argument of the action requested for this boot
+ */
+uint32_t mailbox_arg(void);
+
+/**
+ * @brief Request an action for the next boot
+ * 
+ * Used by the bootloader to carry a request over its own reset (e.g. the
+ * image check skip after a data partition update).
+ * 
+ * @param action Action (MAILBOX_ACTION_*)
+ * @param arg Action argument
+ */
+void mailbox_request(uint16_t action, uint32_t arg);
+
+/**
+ * @brief Record how the application is started (MAILBOX_RESULT_*)
+ * 
+ * @param result Result code, stored in last_result
+ */
+void mailbox_set_result(uint32_t result);
+
+#endif /* BOOT_MAILBOX_H */
@@ -27,6 +27,8 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "config.h"
+#include "sha256.h"
 
 /**
  * @brief Application header structure
@@ -38,6 +40,16 @@ SOFTWARE.
  * identifiers that the bootloader will use in DFU mode. If no valid
  * application is present (magic != 0xDEADBEEF), the bootloader falls
  * back to default VID/PID values defined in config.h.
+ * 
+ * The flags field holds APP_FLAG_* options (see config.h). Images built
+ * before the field existed carry zero there, which selects the defaults.
+ * 
+ * Header version 2 adds a TLV extension area directly after this structure,
+ * in the padding before the vector table (offset 32 up to header_size, at
+ * most APP_VECTOR_TABLE_OFFSET). Each entry is {type, len, value[len]}
+ * without alignment; type APP_TLV_END (0x00) or 0xFF ends the list.
+ * header_crc is the CRC32 of the TLV area. Version 1 images have zero in
+ * header_version, header_size and header_crc (former reserved words).
  */
 typedef struct __attribute__((packed)) {
     uint32_t magic;          /* Magic number: 0xDEADBEEF */
@@ -46,9 +58,48 @@ typedef struct __attribute__((packed)) {
     uint32_t crc32;          /* CRC32 of firmware (excluding this header) */
     uint16_t usb_vid;        /* USB Vendor ID */
     uint16_t usb_pid;        /* USB Product ID */
-    uint32_t reserved[3];    /* Reserved for future use */
+    uint32_t flags;          /* Application flags (APP_FLAG_*) */
+    uint16_t header_version; /* Header version (0 = version 1, APP_HEADER_VERSION) */
+    uint16_t header_size;    /* Header size including TLV area (version 2+) */
+    uint32_t header_crc;     /* CRC32 of TLV area (version 2+) */
 } app_header_t;
 
+/**
+ * @brief Verified-image record
+ * 
+ * Stored in the image store (IMAGE_STORE_RECORD) once the bootloader has
+ * computed the SHA-256 digest of the installed image, so boot-time checks
+ * compare the record against the header instead of rehashing the image. The
+ * flags cache checks that are too slow to repeat on every boot (signature
+ * verification). Erased before the application partition is first erased
+ * in a DFU session.
+ */
+typedef struct {
+    uint32_t size;                          /* Image size (app_header_t.size) */
+    uint32_t crc32;                         /* Image CRC32 (app_header_t.crc32) */
+    uint8_t sha256[SHA256_DIGEST_SIZE];     /* SHA-256 of image */
+    uint32_t flags;                         /* IMAGE_RECORD_* */
+} image_record_t;
+
+#define IMAGE_RECORD_SIGNED     (1U << 0)   /* APP_TLV_SIGNATURE verified */
+
+/**
+ * @brief Boot measurements (DFU_VENDOR_REQ_BOOT_STATS response, little-endian)
+ * 
+ * Values kept in the key/value store, BOOT_STATS_NONE if never measured.
+ * The DFU start-up time is the one of the current boot once measured.
+ * New fields are only appended, and version is incremented.
+ */
+typedef struct {
+    uint16_t version;               /* BOOT_STATS_VERSION */
+    uint16_t size;                  /* sizeof(boot_stats_t) */
+    uint32_t signature_cycles;      /* Last signature check (KV_KEY_SIGNATURE_CYCLES) */
+    uint32_t dfu_ready_us;          /* Kernel start to first DFU_GETSTATUS (KV_KEY_DFU_READY_US) */
+} boot_stats_t;
+
+#define BOOT_STATS_VERSION      2
+#define BOOT_STATS_NONE         0xFFFFFFFF
+
 /**
  * @brief Bootloader state
  */
@@ -71,6 +122,7 @@ int bootloader_init(void);
  * 
  * Checks various conditions:
  * - Magic value in RAM
+ * - DFU or data update request in the boot mailbox
  * - Invalid application firmware
  * - User button pressed
  * - Watchdog reset (commented out until watchdog implemented)
@@ -84,23 +136,117 @@ bool bootloader_should_enter(void);
  * 
  * Enters update mode and waits for firmware via USB DFU.
  * This function blocks until update is complete or timeout.
+ * DFU flash operations wait for a pending background application check.
+ * The DFU start-up time is stored under KV_KEY_DFU_READY_US on exit.
  */
 void bootloader_run(void);
 
+/**
+ * @brief Check if the application check is still running
+ * 
+ * DFU requests (magic value, boot mailbox, user button) enter DFU mode
+ * without checking the application. It is then checked in the background
+ * with bootloader_validate_background() while USB enumerates.
+ * 
+ * @return true if the application check result is not known yet
+ */
+bool bootloader_validation_pending(void);
+
+/**
+ * @brief Validate application and publish the result for DFU mode
+ * 
+ * Runs in the background validation thread (see main.c). The result
+ * decides whether the DFU timeout may leave for the application.
+ */
+void bootloader_validate_background(void);
+
+/**
+ * @brief Check if the installed application passed its image check
+ * 
+ * False while the check is pending, when it was skipped on a boot mailbox
+ * request, or once the application partition was written over DFU.
+ * 
+ * @return true if the installed image is known to be valid
+ */
+bool bootloader_app_verified(void);
+
+/**
+ * @brief Get the boot measurements
+ * 
+ * Loaded from the key/value store once DFU mode has it to itself, updated
+ * when measured. Safe in ISR context.
+ * 
+ * @param[out] stats Report
+ */
+void bootloader_boot_stats_get(boot_stats_t *stats);
+
 /**
  * @brief Validate application firmware
  * 
- * Checks application header and verifies CRC32.
+ * Checks application header and verifies CRC32. The CRC32/digest check is
+ * skipped when the boot mailbox carries a MAILBOX_ACTION_SKIP_CHECK or
+ * MAILBOX_ACTION_DATA_UPDATE request for the installed image (matching
+ * CRC32) and the application partition was not written over DFU.
+ * The result is kept for the rest of the boot, the application is only
+ * checked again once the application partition was written over DFU.
  * 
  * @return true if application is valid, false otherwise
  */
 bool bootloader_validate_app(void);
 
+/**
+ * @brief Find TLV extension in application header
+ * 
+ * Unknown types are skipped by their length. Version 1 headers have no
+ * TLV area.
+ * 
+ * @param header Application header (validated magic)
+ * @param type TLV type (APP_TLV_*)
+ * @param[out] len Value length in bytes (may be NULL)
+ * @return Pointer to value (unaligned), or NULL if not present
+ */
+const uint8_t *bootloader_find_tlv(const app_header_t *header, uint8_t type, uint8_t *len);
+
+/**
+ * @brief Store verified-image record for the installed application
+ * 
+ * Called at DFU manifestation with the digest streamed during download.
+ * If the header carries an APP_TLV_SHA256 entry, it must match. With
+ * USE_IMAGE_SIGNATURE the APP_TLV_SIGNATURE entry is verified over the
+ * digest and the result is cached in the record.
+ * 
+ * @param digest SHA-256 of the image (vector table to end)
+ * @return 0 on success, ERR_INVALID_HEADER if no valid header,
+ *         ERR_INVALID_CRC if the digest does not match the header,
+ *         ERR_INVALID_SIGNATURE if the signature is missing or invalid,
+ *         negative error code if the record could not be stored
+ */
+int bootloader_record_image(const uint8_t digest[SHA256_DIGEST_SIZE]);
+
+/**
+ * @brief Forget the verified-image record and page table
+ * 
+ * Called before the application flash is changed, so a record never
+ * outlives the image it was computed from.
+ * 
+ * @return 0 on success, negative error code on failure
+ */
+int bootloader_forget_image(void);
+
+/**
+ * @brief Drop the cached key/value store context
+ * 
+ * Called when the Data partition (the key/value store) is erased or written
+ * over DFU. The store is opened again from flash on its next use.
+ */
+void bootloader_kv_reload(void);
+
 /**
  * @brief Jump to application firmware
  * 
- * Relocates vector table and transfers control to application.
- * This function does not return if successful.
+ * Restores the reset-default clock configuration (unless the application
+ * requested a warm handoff), relocates vector table and transfers control
+ * to application. This function does not return if successful.
  */
 void bootloader_jump_to_app(void);
 
@@ -125,6 +271,17 @@ void bootloader_timeout_init(void);
  */
 void bootloader_timeout_reset(void);
 
+/**
+ * @brief Set bootloader timeout for this boot
+ * 
+ * Used for DFU requests from the boot mailbox. Values above
+ * BOOTLOADER_TIMEOUT_MAX_MS are limited to it.
+ * 
+ * @param ms Timeout in milliseconds, 0 = BOOTLOADER_TIMEOUT_MS,
+ *           MAILBOX_TIMEOUT_NONE = no timeout
+ */
+void bootloader_timeout_set(uint32_t ms);
+
 /**
  * @brief Check if bootloader timeout has expired
  * 
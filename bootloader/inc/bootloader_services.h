@@ -0,0 +1,86 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef BOOTLOADER_SERVICES_H
+#define BOOTLOADER_SERVICES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "kv_store.h"
+
+/**
+ * @brief Service table magic number
+ */
+#define BL_SERVICES_MAGIC       0xB007C0DE
+
+/**
+ * @brief Service table layout version
+ * 
+ * Increment when entries are appended. Existing entries must never be
+ * moved or removed, so applications built against an older layout keep
+ * working with a newer bootloader.
+ */
+#define BL_SERVICES_VERSION     3
+
+/**
+ * @brief Bootloader service table
+ * 
+ * Placed at BL_SERVICES_ADDR (see config.h), so applications can call the
+ * bootloader's CRC32 and flash routines instead of linking their own copy.
+ * 
+ * All routines are free of bootloader RAM state and safe to call from
+ * application context. The flash erase/write entries only accept addresses
+ * inside the application region. The key/value entries operate on a
+ * kv_store_t owned by the caller.
+ * 
+ * The application side copy of this structure is in
+ * test-firmwares/template/bootloader_services.h.
+ */
+typedef struct {
+    uint32_t magic;          /* BL_SERVICES_MAGIC */
+    uint16_t version;        /* Table layout version (BL_SERVICES_VERSION) */
+    uint16_t size;           /* Table size in bytes */
+    
+    /* Version 1 */
+    uint32_t (*get_version)(void);
+    uint32_t (*crc32_init)(void);
+    uint32_t (*crc32_update)(uint32_t crc, const uint8_t *data, size_t len);
+    uint32_t (*crc32_finalize)(uint32_t crc);
+    int (*flash_unlock)(void);
+    int (*flash_lock)(void);
+    int (*flash_erase_pages)(uint32_t addr, size_t len);
+    int (*flash_write)(uint32_t addr, const uint8_t *data, size_t len);
+    
+    /* Version 2 */
+    int (*kv_init)(kv_store_t *kv);
+    int (*kv_get)(const kv_store_t *kv, uint16_t key, uint8_t *buf, size_t buf_len, size_t *out_len);
+    int (*kv_set)(kv_store_t *kv, uint16_t key, const uint8_t *data, size_t len);
+    int (*kv_delete)(kv_store_t *kv, uint16_t key);
+    
+    /* Version 3 */
+    uint32_t (*crc32_combine)(uint32_t crc_a, uint32_t crc_b, size_t len_b);
+} bl_services_t;
+
+#endif /* BOOTLOADER_SERVICES_H */
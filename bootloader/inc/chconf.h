@@ -634,9 +634,10 @@
  *          runtime measurement of the used stack.
  *
  * @note    The default is @p FALSE.
+ * @note    Enabled for the idle thread high-water mark (ram_stats.c).
  */
 #if !defined(CH_DBG_FILL_THREADS)
-#define CH_DBG_FILL_THREADS                 FALSE
+#define CH_DBG_FILL_THREADS                 TRUE
 #endif
 
 /**
@@ -28,23 +28,61 @@ SOFTWARE.
 #include <stdint.h>
 #include <stdbool.h>
 
-/* Memory Map Configuration */
+/* Target flash/RAM geometry (inc/targets/<BL_TARGET>/target.h) */
+#include "target.h"
+
+/* Memory Map Configuration (derived from the target geometry) */
 #define FLASH_BASE_ADDRESS      0x08000000
-#define FLASH_TOTAL_SIZE        (128 * 1024)  /* 128KB */
-#define FLASH_PAGE_SIZE         2048          /* 2KB pages */
+#define FLASH_TOTAL_SIZE        TARGET_FLASH_SIZE
+#define FLASH_PAGE_SIZE         TARGET_FLASH_PAGE_SIZE
+#define FLASH_ROW_SIZE          TARGET_FLASH_ROW_SIZE
+#define FLASH_WRITE_SIZE        8             /* Programming unit (double-word) */
 
-#define BOOTLOADER_BASE         0x08000000
-#define BOOTLOADER_SIZE         (16 * 1024)   /* 16KB */
+#define BOOTLOADER_BASE         FLASH_BASE_ADDRESS
+#define BOOTLOADER_SIZE         TARGET_BOOTLOADER_SIZE
 
-#define APP_BASE                0x08004000
-#define APP_MAX_SIZE            (112 * 1024)  /* 112KB */
 #define FLASH_END               (FLASH_BASE_ADDRESS + FLASH_TOTAL_SIZE)
 
+/* Key/value store (reserved pages at end of flash, not part of application) */
+#define KV_PAGES                2             /* Minimum 2 for garbage collection */
+#define KV_SIZE                 (KV_PAGES * FLASH_PAGE_SIZE)
+#define KV_BASE                 (FLASH_END - KV_SIZE)
+
+/* Calibration partition (raw data, below key/value store) */
+#define CAL_PAGES               1
+#define CAL_SIZE                (CAL_PAGES * FLASH_PAGE_SIZE)
+#define CAL_BASE                (KV_BASE - CAL_SIZE)
+
+/* Image store (bootloader-private page below calibration, not part of any
+ * DFU partition or of the region the service table may program) */
+#define IMAGE_STORE_SIZE        FLASH_PAGE_SIZE
+#define IMAGE_STORE_BASE        (CAL_BASE - IMAGE_STORE_SIZE)
+
+#define APP_BASE                (BOOTLOADER_BASE + BOOTLOADER_SIZE)
+#define APP_MAX_SIZE            (IMAGE_STORE_BASE - APP_BASE)  /* 104KB on STM32C071xB */
+#define APP_END                 (APP_BASE + APP_MAX_SIZE)
+
+/* Image store entry types */
+#define IMAGE_STORE_RECORD      1             /* Verified-image record (image_record_t) */
+#define IMAGE_STORE_PAGE_TABLE  2             /* Per-page CRC32 table (page_table_t) */
+
+/* Key/value store keys reserved for the bootloader (top of key range,
+ * rejected by the service table kv_set/kv_delete, 61 and 63 unused) */
+#define KV_KEY_RESERVED_FIRST   59
+#define KV_KEY_SIGNATURE_CYCLES 62            /* uint32_t: CPU cycles of last signature check */
+#define KV_KEY_CHECK_CURSOR     60            /* uint8_t: next page of the partial boot check */
+#define KV_KEY_DFU_READY_US     59            /* uint32_t: kernel start to first DFU GETSTATUS (us) */
+
+/* Bootloader service table (fixed address, last 256 bytes of bootloader flash) */
+#define BL_SERVICES_SIZE        256
+#define BL_SERVICES_ADDR        (BOOTLOADER_BASE + BOOTLOADER_SIZE - BL_SERVICES_SIZE)
+
 #define RAM_BASE                0x20000000
-#define RAM_SIZE                (24 * 1024)   /* 24KB */
+#define RAM_SIZE                TARGET_RAM_SIZE
 
 /* USB Configuration */
 #define USB_PACKET_SIZE         64
+#define USB_DISCONNECT_MS       10      /* Minimum bus disconnect before connecting, counted from reset */
 
 /* USB VID/PID Source Configuration
  * When defined: Bootloader reads VID/PID from application header (if valid magic),
@@ -63,9 +101,18 @@ SOFTWARE.
 #define BOOTLOADER_MAGIC        0xDEADBEEF
 #define BOOTLOADER_MAGIC_ADDR   (RAM_BASE + RAM_SIZE - 4)
 
+/* Boot mailbox (boot_mailbox.h), directly below the magic word. The top
+ * BOOT_MAILBOX_RESERVED bytes of RAM are kept out of ram0 by the bootloader
+ * and application linker scripts. */
+#define BOOT_MAILBOX_RESERVED   32
+#define BOOT_MAILBOX_ADDR       (RAM_BASE + RAM_SIZE - BOOT_MAILBOX_RESERVED)
+
 /* Application Header Magic */
 #define APP_HEADER_MAGIC        0xDEADBEEF
 
+/* Application Header Flags (app_header_t.flags) */
+#define APP_FLAG_WARM_HANDOFF   (1U << 0)  /* Keep bootloader clock configuration at jump */
+
 /* Application Memory Layout */
 /* ARM Cortex-M0+ requires vector table aligned to 256-byte boundary
  * (next power-of-2 >= vector table size of 192 bytes = 256 bytes)
@@ -76,11 +123,71 @@ SOFTWARE.
  * 0x08004100: Vector table (256-byte aligned)
  */
 #define APP_HEADER_SIZE         32
+
+/* Application Header Version 2 (TLV extension area after the 32-byte header)
+ * TLVs are read from bootloader 2.0.0 (0x00020000) on. Older bootloaders
+ * ignore the area, including APP_TLV_MIN_BL_VERSION. */
+#define APP_HEADER_VERSION      2
+#define APP_TLV_END             0x00  /* End of TLV list (0xFF also ends it) */
+#define APP_TLV_MIN_BL_VERSION  0x01  /* uint32_t: minimum bootloader version */
+#define APP_TLV_SHA256          0x02  /* uint8_t[32]: SHA-256 of image (vector table to end) */
+#define APP_TLV_SIGNATURE       0x03  /* uint8_t[64]: Ed25519 signature of the SHA-256 digest */
 #define APP_VECTOR_ALIGNMENT    256
 #define APP_VECTOR_TABLE_OFFSET 0x100  /* 256 bytes from APP_BASE */
 
+/* Boot Clock Configuration
+ * When defined: Flash prefetch and instruction cache are enabled while the
+ *               application is validated (SYSCLK already runs at 48MHz, see
+ *               mcuconf.h). The reset-default clock configuration is restored
+ *               before the jump, unless the application header sets
+ *               APP_FLAG_WARM_HANDOFF.
+ * When undefined: Clocks are left as configured by ChibiOS (mcuconf.h).
+ */
+#define USE_BOOT_CLOCK_BOOST
+
+/* Image Signature Configuration
+ * When defined: Applications must carry an APP_TLV_SHA256 digest and an
+ *               APP_TLV_SIGNATURE (Ed25519 over the 32-byte digest) made with
+ *               the key matching IMAGE_SIGNATURE_PUBLIC_KEY. The signature is
+ *               checked once at DFU manifestation (or on first boot for images
+ *               flashed otherwise) and cached in the verified-image record.
+ * When undefined: Signatures are ignored.
+ * 
+ * Public key (32 bytes) from a private key in PEM format:
+ *   openssl pkey -in key.pem -pubout -outform DER | tail -c 32 | xxd -i
+ */
+//#define USE_IMAGE_SIGNATURE
+//#define IMAGE_SIGNATURE_PUBLIC_KEY { 0x00, 0x00, ... }
+
+/* Partial Boot Check Configuration
+ * When defined: A table of per-page CRC32 values is built at DFU manifestation
+ *               (or after the first full check) and stored in the image
+ *               store (IMAGE_STORE_PAGE_TABLE, not the key/value store).
+ *               Each boot checks the vector table page and BOOT_CHECK_PAGES
+ *               further pages in rotation instead of the whole image, so
+ *               every page is covered over a few boots. Only the rotation
+ *               cursor is kept in the key/value store.
+ *               A mismatch falls back to the full CRC32 check.
+ * When undefined: The whole image is checked on every boot.
+ */
+//#define USE_PARTIAL_BOOT_CHECK
+#define BOOT_CHECK_PAGES        4             /* Pages per boot besides the vector table page */
+
+/* Identical Image Skip Configuration
+ * When defined: The application erase is deferred to the first data block.
+ *               If that block holds the header of the installed, fully
+ *               checked image (same version, size and CRC32) and matches
+ *               flash, the session is acknowledged without erasing or
+ *               programming; the remaining blocks are only compared with
+ *               flash. DFU_GETSTATUS then reports iString 7
+ *               ("Already up to date").
+ * When undefined: Every download erases and programs the application.
+ */
+#define USE_DFU_SKIP_IDENTICAL
+
 /* Timeouts (in milliseconds) */
 #define BOOTLOADER_TIMEOUT_MS   60000  /* 60 seconds - auto-jump to app if no USB activity */
+#define BOOTLOADER_TIMEOUT_MAX_MS 600000 /* 10 minutes - limit for timeouts requested via boot mailbox */
 
 /* Error Codes */
 #define ERR_SUCCESS             0
@@ -93,5 +200,17 @@ SOFTWARE.
 #define ERR_INVALID_CRC        -7
 #define ERR_USB_ERROR          -8
 #define ERR_INVALID_HEADER     -9
+#define ERR_NOT_FOUND          -10
+#define ERR_NO_SPACE           -11
+#define ERR_INVALID_SIGNATURE  -12
+
+/* Geometry checks (every target is checked when it is built) */
+_Static_assert((FLASH_PAGE_SIZE & (FLASH_PAGE_SIZE - 1)) == 0, "Flash page size must be a power of two");
+_Static_assert(FLASH_PAGE_SIZE % FLASH_ROW_SIZE == 0 && FLASH_ROW_SIZE % FLASH_WRITE_SIZE == 0,
+               "Row size must divide the page size and be a multiple of the double-word");
+_Static_assert(FLASH_TOTAL_SIZE % FLASH_PAGE_SIZE == 0, "Flash size must be a multiple of the page size");
+_Static_assert(BOOTLOADER_SIZE % FLASH_PAGE_SIZE == 0, "Bootloader must end on a page boundary");
+_Static_assert(APP_BASE % APP_VECTOR_ALIGNMENT == 0, "Application base must be vector table aligned");
+_Static_assert(APP_MAX_SIZE >= 4 * FLASH_PAGE_SIZE, "No room for the application");
 
 #endif /* CONFIG_H */
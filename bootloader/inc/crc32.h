@@ -62,4 +62,38 @@ uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len);
  */
 uint32_t crc32_finalize(uint32_t crc);
 
+/**
+ * @brief Combine CRC32 of two adjacent data blocks
+ * 
+ * Returns the CRC32 of A followed by B, given the CRC32 of A, the CRC32 of
+ * B and the length of B, without reading the data again.
+ * 
+ * @param crc_a Final CRC32 of first block
+ * @param crc_b Final CRC32 of second block
+ * @param len_b Length of second block in bytes
+ * @return CRC32 of both blocks
+ */
+uint32_t crc32_combine(uint32_t crc_a, uint32_t crc_b, size_t len_b);
+
+/**
+ * @brief Generate combine operator for a fixed block length
+ * 
+ * For repeated combines with the same length (e.g. flash pages), generate
+ * the operator once and use crc32_combine_op().
+ * 
+ * @param len_b Length of second block in bytes
+ * @return Combine operator
+ */
+uint32_t crc32_combine_gen(size_t len_b);
+
+/**
+ * @brief Combine CRC32 of two adjacent data blocks with precomputed operator
+ * 
+ * @param crc_a Final CRC32 of first block
+ * @param crc_b Final CRC32 of second block
+ * @param op Operator from crc32_combine_gen() for the length of the second block
+ * @return CRC32 of both blocks
+ */
+uint32_t crc32_combine_op(uint32_t crc_a, uint32_t crc_b, uint32_t op);
+
 #endif /* CRC32_H */
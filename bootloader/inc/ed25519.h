@@ -0,0 +1,59 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef ED25519_H
+#define ED25519_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Ed25519 public key size in bytes
+ */
+#define ED25519_PUBLIC_KEY_SIZE     32
+
+/**
+ * @brief Ed25519 signature size in bytes
+ */
+#define ED25519_SIGNATURE_SIZE      64
+
+/**
+ * @brief Verify Ed25519 signature (RFC 8032, pure Ed25519)
+ * 
+ * Runs in constant time with respect to its inputs. Uses static work
+ * memory, not reentrant.
+ * 
+ * @param sig Signature (ED25519_SIGNATURE_SIZE bytes)
+ * @param msg Signed message
+ * @param len Message length in bytes
+ * @param public_key Public key (ED25519_PUBLIC_KEY_SIZE bytes)
+ * @return true if the signature is valid, false otherwise
+ */
+bool ed25519_verify(const uint8_t sig[ED25519_SIGNATURE_SIZE],
+                    const uint8_t *msg, size_t len,
+                    const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE]);
+
+#endif /* ED25519_H */
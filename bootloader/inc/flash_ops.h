@@ -62,6 +62,16 @@ int flash_erase_pages(uint32_t addr, size_t len);
  */
 int flash_write(uint32_t addr, const uint8_t *data, size_t len);
 
+/**
+ * @brief Write double-word (64-bit) to flash
+ * 
+ * @param addr Destination address (must be aligned to 8 bytes)
+ * @param word1 First (low) word
+ * @param word2 Second (high) word
+ * @return 0 on success, negative error code on failure
+ */
+int flash_write_doubleword(uint32_t addr, uint32_t word1, uint32_t word2);
+
 /**
  * @brief Write word to flash
  * 
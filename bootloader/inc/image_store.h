@@ -0,0 +1,66 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IMAGE_STORE_H
+#define IMAGE_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Read the latest entry of a type
+ * 
+ * @param type Entry type (IMAGE_STORE_* in config.h)
+ * @param buf Destination buffer
+ * @param buf_len Size of destination buffer
+ * @param out_len Entry length in bytes (may be NULL)
+ * @return 0 on success, ERR_NOT_FOUND if there is no entry of the type,
+ *         ERR_INVALID_PARAM if buffer is too small
+ */
+int image_store_read(uint16_t type, uint8_t *buf, size_t buf_len, size_t *out_len);
+
+/**
+ * @brief Write entry
+ * 
+ * Appends the entry to the page. A full page is erased first, which drops
+ * the entries of other types.
+ * 
+ * @param type Entry type (IMAGE_STORE_* in config.h)
+ * @param data Entry data
+ * @param len Entry length (1 to IMAGE_STORE_SIZE - 16)
+ * @return 0 on success, negative error code on failure
+ */
+int image_store_write(uint16_t type, const uint8_t *data, size_t len);
+
+/**
+ * @brief Erase all entries
+ * 
+ * Does not erase a page that is already blank.
+ * 
+ * @return 0 on success, negative error code on failure
+ */
+int image_store_erase(void);
+
+#endif /* IMAGE_STORE_H */
@@ -0,0 +1,114 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef KV_STORE_H
+#define KV_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Number of keys (valid keys are 0 to KV_MAX_KEYS - 1)
+ */
+#define KV_MAX_KEYS         64
+
+/**
+ * @brief Maximum value length in bytes
+ */
+#define KV_MAX_VALUE_LEN    256
+
+/**
+ * @brief Key/value store context
+ * 
+ * Holds the RAM index of the log in the active flash page. Owned by the
+ * caller, so the store can be used both from bootloader and application
+ * context (through the service table). Treat as opaque.
+ */
+typedef struct {
+    uint32_t page_addr;             /* Active page address */
+    uint32_t sequence;              /* Active page sequence number */
+    uint16_t write_offset;          /* Next free offset in active page */
+    uint16_t index[KV_MAX_KEYS];    /* Record offset per key, 0 = not present */
+} kv_store_t;
+
+/**
+ * @brief Initialize key/value store
+ * 
+ * Finds the active page in the KV region, rebuilds the RAM index from the
+ * log and formats the region if no valid page exists.
+ * 
+ * @param kv Store context
+ * @return 0 on success, negative error code on failure
+ */
+int kv_init(kv_store_t *kv);
+
+/**
+ * @brief Check if the KV region holds a valid page
+ * 
+ * Used to verify a key/value image written over DFU, before kv_init()
+ * would discard it by formatting the region.
+ * 
+ * @return true if at least one page has a valid page header
+ */
+bool kv_is_formatted(void);
+
+/**
+ * @brief Read value
+ * 
+ * @param kv Store context
+ * @param key Key (0 to KV_MAX_KEYS - 1)
+ * @param buf Destination buffer
+ * @param buf_len Size of destination buffer
+ * @param out_len Value length in bytes (may be NULL)
+ * @return 0 on success, ERR_NOT_FOUND if key has no value,
+ *         ERR_INVALID_PARAM if buffer is too small
+ */
+int kv_get(const kv_store_t *kv, uint16_t key, uint8_t *buf, size_t buf_len, size_t *out_len);
+
+/**
+ * @brief Write value
+ * 
+ * Appends a record to the log. Writing the value already stored is a no-op.
+ * The active page is garbage collected into the next page when full.
+ * 
+ * @param kv Store context
+ * @param key Key (0 to KV_MAX_KEYS - 1)
+ * @param data Value data
+ * @param len Value length (1 to KV_MAX_VALUE_LEN)
+ * @return 0 on success, negative error code on failure
+ */
+int kv_set(kv_store_t *kv, uint16_t key, const uint8_t *data, size_t len);
+
+/**
+ * @brief Delete value
+ * 
+ * @param kv Store context
+ * @param key Key (0 to KV_MAX_KEYS - 1)
+ * @return 0 on success (also if key had no value), negative error code on failure
+ */
+int kv_delete(kv_store_t *kv, uint16_t key);
+
+#endif /* KV_STORE_H */
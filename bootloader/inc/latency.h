@@ -0,0 +1,121 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ch.h"
+
+/**
+ * @brief Latency histograms
+ * 
+ * One per DFU request type (index = bRequest), from setup packet reception
+ * in the request hook to the response being queued, plus
+ * LATENCY_PROGRAM: DNLOAD data stage complete to programming (or DFUSe
+ * command) start in usb_dfu_process().
+ */
+typedef enum {
+    LATENCY_DETACH = 0,
+    LATENCY_DNLOAD,
+    LATENCY_UPLOAD,             /* Not supported, stays empty */
+    LATENCY_GETSTATUS,
+    LATENCY_CLRSTATUS,
+    LATENCY_GETSTATE,
+    LATENCY_ABORT,
+    LATENCY_PROGRAM,
+    LATENCY_COUNT
+} latency_id_t;
+
+/**
+ * @brief Log-scale histogram buckets
+ * 
+ * Bucket 0: below 1us, bucket k: [2^(k-1), 2^k) us, the last bucket also
+ * counts everything above (16.4ms and more).
+ */
+#define LATENCY_BUCKETS         16
+
+/**
+ * @brief Latency histogram (counts saturate at 0xFFFF)
+ */
+typedef struct {
+    uint16_t count[LATENCY_BUCKETS];
+    uint32_t max_us;
+} latency_hist_t;
+
+/**
+ * @brief Latency report (DFU_VENDOR_REQ_LATENCY response, little-endian)
+ */
+typedef struct {
+    uint16_t version;                   /* LATENCY_VERSION */
+    uint16_t size;                      /* sizeof(latency_stats_t) */
+    latency_hist_t hist[LATENCY_COUNT]; /* Indexed by latency_id_t */
+} latency_stats_t;
+
+#define LATENCY_VERSION         1
+
+/**
+ * @brief Start time of a measurement
+ * 
+ * SysTick cycle count (24-bit, wraps after 349ms at 48MHz) with the system
+ * time for longer intervals.
+ */
+typedef struct {
+    uint32_t cycles;
+    systime_t time;
+} latency_stamp_t;
+
+/**
+ * @brief Start the SysTick cycle counter and clear the histograms
+ * 
+ * SysTick is not used by the kernel (system tick on TIM16). The bootloader
+ * resets before an application is started from DFU mode.
+ */
+void latency_init(void);
+
+/**
+ * @brief Take a start time (ISR or thread context)
+ * 
+ * @param[out] stamp Start time
+ */
+void latency_stamp(latency_stamp_t *stamp);
+
+/**
+ * @brief Record the time elapsed since a start time (ISR or thread context)
+ * 
+ * @param id Histogram
+ * @param stamp Start time from latency_stamp()
+ */
+void latency_record(latency_id_t id, const latency_stamp_t *stamp);
+
+/**
+ * @brief Copy the histograms
+ * 
+ * @param[out] stats Report
+ * @param clear Clear the histograms after copying
+ */
+void latency_get(latency_stats_t *stats, bool clear);
+
+#endif /* LATENCY_H */
@@ -0,0 +1,100 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef PAGE_TABLE_H
+#define PAGE_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "config.h"
+
+/**
+ * @brief Number of flash pages an application image can span
+ * 
+ * The image (from the vector table) is at most APP_MAX_SIZE -
+ * APP_VECTOR_TABLE_OFFSET bytes, so it never reaches past APP_END.
+ */
+#define PAGE_TABLE_MAX_PAGES    ((APP_MAX_SIZE + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE)
+
+/**
+ * @brief Per-page CRC32 table (USE_PARTIAL_BOOT_CHECK)
+ * 
+ * Stored in the image store (IMAGE_STORE_PAGE_TABLE). Entry i is the CRC32
+ * of the image bytes in flash page i of the application region; page 0
+ * starts at the vector table. Combined in order, the entries give the
+ * image CRC32, which binds the table to the header.
+ */
+typedef struct {
+    uint32_t size;                              /* Image size (app_header_t.size) */
+    uint32_t crc32;                             /* Image CRC32 (app_header_t.crc32) */
+    uint32_t page_crc[PAGE_TABLE_MAX_PAGES];    /* CRC32 per page */
+} page_table_t;
+
+/**
+ * @brief Number of flash pages spanned by an image
+ * 
+ * @param size Image size (app_header_t.size, at most APP_MAX_SIZE -
+ *             APP_VECTOR_TABLE_OFFSET)
+ * @return Page count, page 0 holds the header and the vector table
+ */
+uint32_t page_table_pages(uint32_t size);
+
+/**
+ * @brief Build the table of the image in flash
+ * 
+ * @param table Table to fill
+ * @param size Image size
+ * @param crc32 Image CRC32 from the header
+ * @return Table length in bytes (stored length)
+ */
+size_t page_table_build(page_table_t *table, uint32_t size, uint32_t crc32);
+
+/**
+ * @brief Check that a stored table belongs to an image
+ * 
+ * The table must match size and CRC32 of the header and its entries must
+ * combine to the image CRC32 (no flash reads).
+ * 
+ * @param table Table read from the image store
+ * @param len Stored length in bytes
+ * @param size Image size from the header
+ * @param crc32 Image CRC32 from the header
+ * @return true if the table can be used
+ */
+bool page_table_valid(const page_table_t *table, size_t len, uint32_t size, uint32_t crc32);
+
+/**
+ * @brief Check the vector table page and @p count further pages in rotation
+ * 
+ * @param table Valid table (page_table_valid())
+ * @param[in,out] cursor First page of the rotation (1 to pages - 1, other
+ *                values restart at 1), next page to check on return
+ * @param count Pages to check besides page 0
+ * @return true if all checked pages match
+ */
+bool page_table_check(const page_table_t *table, uint8_t *cursor, uint32_t count);
+
+#endif /* PAGE_TABLE_H */
@@ -0,0 +1,102 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef RAM_STATS_H
+#define RAM_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Stacks with a high-water mark
+ * 
+ * Stacks are filled with RAM_STATS_FILL_PATTERN before use (startup code
+ * for the exception and process stacks, CH_DBG_FILL_THREADS for the RT
+ * idle thread, ram_stats_add_stack() for the working areas in main.c).
+ * A stack not present in the build reports size 0.
+ */
+typedef enum {
+    RAM_STACK_EXCEPTIONS = 0,   /* Main stack: interrupts and exceptions */
+    RAM_STACK_MAIN,             /* Process stack: main() thread (RT), idle thread (NIL) */
+    RAM_STACK_IDLE,             /* Idle thread (RT) */
+    RAM_STACK_BOOTLOADER,       /* Bootloader thread (NIL) */
+    RAM_STACK_VALIDATE,         /* Background validation thread */
+    RAM_STACK_COUNT
+} ram_stack_t;
+
+/* Same as the startup code (CRT0_STACKS_FILL_PATTERN) and CH_DBG_STACK_FILL_VALUE */
+#define RAM_STATS_FILL_PATTERN  0x55555555
+
+/**
+ * @brief Stack size and high-water mark in bytes
+ * 
+ * Thread working areas include the thread structure/context at the top.
+ */
+typedef struct {
+    uint16_t size;
+    uint16_t used;
+} ram_stack_usage_t;
+
+/**
+ * @brief RAM usage report (DFU_VENDOR_REQ_RAM_STATS response, little-endian)
+ * 
+ * ram_size is the bootloader RAM (ram0). The rest of ram0 after stacks,
+ * data, bss and free_size holds no-init sections and alignment.
+ * New fields are only appended, and version is incremented.
+ */
+typedef struct {
+    uint16_t version;                           /* RAM_STATS_VERSION */
+    uint16_t size;                              /* sizeof(ram_stats_t) */
+    uint32_t ram_size;                          /* Bootloader RAM (ram0) */
+    uint32_t data_size;                         /* .data */
+    uint32_t bss_size;                          /* .bss (includes thread working areas) */
+    uint32_t free_size;                         /* Not allocated (heap region, unused) */
+    ram_stack_usage_t stack[RAM_STACK_COUNT];   /* Indexed by ram_stack_t */
+    uint16_t xfer_size;                         /* DFU download buffer (DFU_XFER_SIZE) */
+    uint16_t xfer_peak;                         /* Largest download block received */
+} ram_stats_t;
+
+#define RAM_STATS_VERSION       1
+
+/**
+ * @brief Register a thread working area and fill it with the stack pattern
+ * 
+ * Must be called before the thread is started.
+ * 
+ * @param id Stack identifier
+ * @param base Working area base address
+ * @param size Working area size in bytes
+ */
+void ram_stats_add_stack(ram_stack_t id, void *base, size_t size);
+
+/**
+ * @brief Collect the RAM usage report
+ * 
+ * Scans all stacks for the fill pattern. Safe in ISR context.
+ * 
+ * @param[out] stats Report
+ */
+void ram_stats_get(ram_stats_t *stats);
+
+#endif /* RAM_STATS_H */
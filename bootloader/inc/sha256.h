@@ -0,0 +1,84 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef SHA256_H
+#define SHA256_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief SHA-256 digest size in bytes
+ */
+#define SHA256_DIGEST_SIZE  32
+
+/**
+ * @brief SHA-256 block size in bytes
+ */
+#define SHA256_BLOCK_SIZE   64
+
+/**
+ * @brief SHA-256 streaming context
+ */
+typedef struct {
+    uint32_t state[8];                  /* Intermediate hash value */
+    uint32_t count;                     /* Total bytes processed */
+    uint8_t buffer[SHA256_BLOCK_SIZE];  /* Partial block */
+} sha256_ctx_t;
+
+/**
+ * @brief Initialize SHA-256 calculation
+ * 
+ * @param ctx Context
+ */
+void sha256_init(sha256_ctx_t *ctx);
+
+/**
+ * @brief Update SHA-256 with new data
+ * 
+ * @param ctx Context
+ * @param data Pointer to data buffer
+ * @param len Length of data in bytes
+ */
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief Finalize SHA-256 calculation
+ * 
+ * @param ctx Context
+ * @param[out] digest Digest (SHA256_DIGEST_SIZE bytes)
+ */
+void sha256_final(sha256_ctx_t *ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+/**
+ * @brief Calculate SHA-256 digest (convenience function)
+ * 
+ * @param data Pointer to data buffer
+ * @param len Length of data in bytes
+ * @param[out] digest Digest (SHA256_DIGEST_SIZE bytes)
+ */
+void sha256_calculate(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE]);
+
+#endif /* SHA256_H */
@@ -0,0 +1,41 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef TARGET_H
+#define TARGET_H
+
+/**
+ * @brief Flash and RAM geometry: STM32C071xB (128KB flash, 24KB RAM)
+ * 
+ * Selected with "make BL_TARGET=stm32c071xb" (include path inc/targets/stm32c071xb).
+ * All memory map constants in config.h, the DFUSe descriptors and the
+ * bootloader linker script regions are derived from these values.
+ */
+#define TARGET_FLASH_SIZE       (128 * 1024)   /* 128KB */
+#define TARGET_FLASH_PAGE_SIZE  2048          /* 2KB erase pages */
+#define TARGET_FLASH_ROW_SIZE   256           /* Fast programming row (32 double-words) */
+#define TARGET_BOOTLOADER_SIZE  (16 * 1024)   /* 16KB, must match the application linker scripts */
+#define TARGET_RAM_SIZE         (24 * 1024)   /* 24KB */
+
+#endif /* TARGET_H */
@@ -88,6 +88,17 @@ typedef enum {
 #define DFUSE_CMD_ERASE         0x41  /* Erase page at address (5 bytes) */
 #define DFUSE_CMD_READ_UNPROTECT 0x92 /* Read unprotect (1 byte) */
 
+/**
+ * @brief Vendor requests (bmRequestType 0xC0/0xC1, device to host)
+ * 
+ * Diagnostics, read with scripts/bl_stats.py. wIndex unused.
+ */
+#define DFU_VENDOR_REQ_RAM_STATS    0x01  /* RAM and stack usage (ram_stats_t) */
+#define DFU_VENDOR_REQ_LATENCY      0x02  /* Request latency histograms (latency_stats_t) */
+#define DFU_VENDOR_REQ_BOOT_STATS   0x03  /* Boot measurements (boot_stats_t) */
+
+#define DFU_VENDOR_LATENCY_CLEAR    0x0001  /* wValue: clear histograms after reading */
+
 /**
  * @brief Initialize USB DFU
  * 
@@ -119,4 +130,47 @@ dfu_state_t usb_dfu_get_state(void);
  */
 bool usb_dfu_download_complete(void);
 
+/**
+ * @brief Check if the application partition was modified
+ * 
+ * Set on the first erase or write of the application partition in this
+ * boot, also if the download did not complete.
+ * 
+ * @return true if the application partition was erased or written
+ */
+bool usb_dfu_app_modified(void);
+
+/**
+ * @brief Check if the downloaded image matched the installed one
+ * 
+ * Set when the first application block shows the image is already
+ * installed (USE_DFU_SKIP_IDENTICAL); the session is then acknowledged
+ * without erasing or programming.
+ * 
+ * @return true if the application partition was left as it was
+ */
+bool usb_dfu_up_to_date(void);
+
+/**
+ * @brief Get time from kernel start to the first DFU_GETSTATUS
+ * 
+ * Host-visible DFU start-up time: bus disconnect, enumeration and the
+ * host's first DFU request. Measured from the bootloader kernel start
+ * (startup code before chSysInit() not included).
+ * 
+ * @param[out] us Time in microseconds
+ * @return true if a DFU_GETSTATUS was received (and processed by
+ *         usb_dfu_process()), false otherwise
+ */
+bool usb_dfu_ready_time(uint32_t *us);
+
+/**
+ * @brief Get the largest DFU download block received in this boot
+ * 
+ * Peak use of the DFU_XFER_SIZE download buffer.
+ * 
+ * @return Block size in bytes, 0 before the first download
+ */
+uint16_t usb_dfu_xfer_peak(void);
+
 #endif /* USB_DFU_H */
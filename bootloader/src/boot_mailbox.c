@@ -0,0 +1,127 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file boot_mailbox.c
+ * @brief CRC-guarded RAM mailbox for application requests
+ * 
+ * The mailbox lives in the top BOOT_MAILBOX_RESERVED bytes of RAM, which
+ * neither the bootloader nor the application linker script assigns to
+ * ram0, so it survives the run of the other image. Only the CRC guard
+ * decides whether the content is trusted.
+ */
+
+#include "boot_mailbox.h"
+#include "config.h"
+#include "crc32.h"
+#include <stddef.h>
+
+_Static_assert(sizeof(boot_mailbox_t) + 4 <= BOOT_MAILBOX_RESERVED,
+               "Boot mailbox overlaps the legacy magic word");
+
+#define MAILBOX     ((volatile boot_mailbox_t *)BOOT_MAILBOX_ADDR)
+
+/* Action and argument consumed on this boot */
+static uint16_t boot_action = MAILBOX_ACTION_NONE;
+static uint32_t boot_arg = 0;
+
+/**
+ * @brief CRC32 of all fields before crc
+ */
+static uint32_t mailbox_crc(void)
+{
+    return crc32_calculate((const uint8_t *)BOOT_MAILBOX_ADDR, offsetof(boot_mailbox_t, crc));
+}
+
+/**
+ * @brief Check magic, layout and CRC guard
+ */
+static bool mailbox_valid(void)
+{
+    return MAILBOX->magic == BOOT_MAILBOX_MAGIC &&
+           MAILBOX->version == BOOT_MAILBOX_VERSION &&
+           MAILBOX->size == sizeof(boot_mailbox_t) &&
+           MAILBOX->crc == mailbox_crc();
+}
+
+/**
+ * @brief Load mailbox and consume the requested action
+ */
+void mailbox_load(void)
+{
+    if (mailbox_valid()) {
+        boot_action = MAILBOX->action;
+        boot_arg = MAILBOX->arg;
+    } else {
+        MAILBOX->magic = BOOT_MAILBOX_MAGIC;
+        MAILBOX->version = BOOT_MAILBOX_VERSION;
+        MAILBOX->size = sizeof(boot_mailbox_t);
+        MAILBOX->boot_count = 0;
+        MAILBOX->last_result = MAILBOX_RESULT_NONE;
+        boot_action = MAILBOX_ACTION_NONE;
+        boot_arg = 0;
+    }
+    
+    MAILBOX->action = MAILBOX_ACTION_NONE;
+    MAILBOX->last_action = boot_action;
+    MAILBOX->arg = 0;
+    MAILBOX->boot_count++;
+    MAILBOX->crc = mailbox_crc();
+}
+
+/**
+ * @brief Action requested for this boot
+ */
+uint16_t mailbox_action(void)
+{
+    return boot_action;
+}
+
+/**
+ * @brief Argument of the action requested for this boot
+ */
+uint32_t mailbox_arg(void)
+{
+    return boot_arg;
+}
+
+/**
+ * @brief Request an action for the next boot
+ */
+void mailbox_request(uint16_t action, uint32_t arg)
+{
+    MAILBOX->action = action;
+    MAILBOX->arg = arg;
+    MAILBOX->crc = mailbox_crc();
+}
+
+/**
+ * @brief Record how the application is started
+ */
+void mailbox_set_result(uint32_t result)
+{
+    MAILBOX->last_result = result;
+    MAILBOX->crc = mailbox_crc();
+}
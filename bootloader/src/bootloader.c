@@ -23,19 +23,111 @@ SOFTWARE.
 */
 
 #include "bootloader.h"
+#include "boot_mailbox.h"
 #include "config.h"
 #include "flash_ops.h"
 #include "crc32.h"
+#include "kv_store.h"
+#include "image_store.h"
+#include "page_table.h"
+#include "ed25519.h"
+#include <string.h>
+#include <stddef.h>
 #include "usb_dfu.h"
 #include "stm32c071xx.h"
 #include "ch.h"
 #include "hal.h"
 
-#define BOOTLOADER_VERSION 0x00010201  /* Version 1.2.1 */
+/* Version 2.0.0: application region 104KB, header version 2 (TLVs, read
+ * from 2.0.0 on), service table version 3, boot mailbox, image signature */
+#define BOOTLOADER_VERSION 0x00020000  /* Version 2.0.0 */
+
+#if defined(USE_IMAGE_SIGNATURE) && !defined(IMAGE_SIGNATURE_PUBLIC_KEY)
+#error "USE_IMAGE_SIGNATURE requires IMAGE_SIGNATURE_PUBLIC_KEY"
+#endif
 
 static bootloader_state_t state = BOOTLOADER_STATE_IDLE;
-static systime_t timeout_start = 0;
+static systime_t timeout_last = 0;
+static sysinterval_t timeout_elapsed = 0;
+static uint32_t timeout_ms = BOOTLOADER_TIMEOUT_MS;
 static bool timeout_enabled = false;
+static bool app_trusted = false;        /* Image check skipped on request this boot */
+
+/**
+ * @brief Application check result of this boot
+ * 
+ * Known when bootloader_should_enter() validated the application, otherwise
+ * set by the background validation (USB is started first). Kept by
+ * bootloader_validate_app() until the application partition is written.
+ */
+typedef enum {
+    APP_CHECK_PENDING,
+    APP_CHECK_VALID,
+    APP_CHECK_INVALID
+} app_check_t;
+
+static volatile app_check_t app_check = APP_CHECK_PENDING;
+
+static kv_store_t kv;
+static bool kv_ready = false;
+
+static boot_stats_t boot_stats = {
+    .version = BOOT_STATS_VERSION,
+    .size = sizeof(boot_stats_t),
+    .signature_cycles = BOOT_STATS_NONE,
+    .dfu_ready_us = BOOT_STATS_NONE
+};
+
+static kv_store_t *bootloader_kv(void);
+
+#ifdef USE_BOOT_CLOCK_BOOST
+/* Flash access configuration saved by bootloader_flash_accel() */
+static uint32_t saved_flash_acr = 0;
+
+/**
+ * @brief Enable flash prefetch and instruction cache for the validation window
+ * 
+ * SYSCLK already runs at its maximum (HSISYS = HSI48 / 1, see mcuconf.h),
+ * so only the flash access path is tuned for the sequential read pattern of
+ * the CRC pass. The previous configuration is restored with
+ * bootloader_flash_accel_restore().
+ */
+static void bootloader_flash_accel(void)
+{
+    saved_flash_acr = FLASH->ACR;
+    FLASH->ACR |= FLASH_ACR_PRFTEN | FLASH_ACR_ICEN;
+}
+
+/**
+ * @brief Restore flash access configuration saved by bootloader_flash_accel()
+ */
+static void bootloader_flash_accel_restore(void)
+{
+    FLASH->ACR = saved_flash_acr;
+}
+
+/**
+ * @brief Restore reset-default SYSCLK and flash configuration
+ * 
+ * Reset default is HSISYS = HSI48 / 4 (12MHz), no prescalers, zero wait
+ * states and prefetch disabled. The application then starts from the same
+ * state as without a bootloader.
+ */
+static void bootloader_clock_reset_default(void)
+{
+    /* Switch SYSCLK to HSISYS and clear bus prescalers */
+    RCC->CFGR = 0;
+    while ((RCC->CFGR & RCC_CFGR_SWS) != 0) {
+        /* Wait for HSISYS to be selected */
+    }
+    
+    /* HSIDIV = 4 (reset value) */
+    RCC->CR = (RCC->CR & ~RCC_CR_HSIDIV) | RCC_CR_HSIDIV_1;
+    
+    /* Zero wait states, prefetch off, instruction cache on (reset value) */
+    FLASH->ACR = (FLASH->ACR & ~(FLASH_ACR_LATENCY | FLASH_ACR_PRFTEN)) | FLASH_ACR_ICEN;
+}
+#endif /* USE_BOOT_CLOCK_BOOST */
 
 /**
  * @brief Initialize bootloader system
@@ -47,6 +139,9 @@ int bootloader_init(void)
 
     state = BOOTLOADER_STATE_IDLE;
     
+    /* Consume application request (boot mailbox) */
+    mailbox_load();
+    
     return ERR_SUCCESS;
 }
 
@@ -63,16 +158,29 @@ bool bootloader_should_enter(void)
         return true;
     }
     
-    /* Check if application is valid */
-    if (!bootloader_validate_app()) {
-        return true;  /* No valid application, stay in bootloader */
+    /* Check for DFU request in boot mailbox */
+    switch (mailbox_action()) {
+    case MAILBOX_ACTION_DFU:
+        bootloader_timeout_set(mailbox_arg());
+        return true;
+    case MAILBOX_ACTION_DATA_UPDATE:
+        return true;
+    default:
+        break;
     }
     
-    /* Check if user button is pressed (active low - externally pulled up) */
+    /* Check if user button is pressed (active low - externally pulled up)
+     * Checked before the application, USB is started without waiting for
+     * the image check on every DFU request */
     if (palReadLine(LINE_USER_BUTTON) == PAL_LOW) {
         return true;  /* User button held during reset, enter bootloader */
     }
     
+    /* Check if application is valid */
+    if (!bootloader_validate_app()) {
+        return true;  /* No valid application, stay in bootloader */
+    }
+    
     
     /* TODO: Implement, when watchdog is implemented */
     //if (RCC->CSR2 & RCC_CSR2_IWDGRSTF) {
@@ -90,7 +198,8 @@ bool bootloader_should_enter(void)
  */
 void bootloader_timeout_init(void)
 {
-    timeout_start = chVTGetSystemTime();
+    timeout_last = chVTGetSystemTime();
+    timeout_elapsed = 0;
     timeout_enabled = true;
 }
 
@@ -99,7 +208,22 @@ void bootloader_timeout_init(void)
  */
 void bootloader_timeout_reset(void)
 {
-    timeout_start = chVTGetSystemTime();
+    timeout_last = chVTGetSystemTime();
+    timeout_elapsed = 0;
+}
+
+/**
+ * @brief Set bootloader timeout for this boot
+ */
+void bootloader_timeout_set(uint32_t ms)
+{
+    if (ms == 0) {
+        ms = BOOTLOADER_TIMEOUT_MS;
+    } else if (ms != MAILBOX_TIMEOUT_NONE && ms > BOOTLOADER_TIMEOUT_MAX_MS) {
+        ms = BOOTLOADER_TIMEOUT_MAX_MS;
+    }
+    
+    timeout_ms = ms;
 }
 
 /**
@@ -108,15 +232,19 @@ void bootloader_timeout_reset(void)
  */
 bool bootloader_timeout_expired(void)
 {
-    if (!timeout_enabled) {
+    if (!timeout_enabled || timeout_ms == MAILBOX_TIMEOUT_NONE) {
         return false;
     }
     
-    systime_t elapsed = chVTTimeElapsedSinceX(timeout_start);
-    sysinterval_t timeout_ticks = TIME_MS2I(BOOTLOADER_TIMEOUT_MS);
+    /* systime_t is 16-bit (wraps after 6.5s at 10kHz), so the time between
+     * calls (every 10ms) is accumulated instead of comparing against the start */
+    systime_t now = chVTGetSystemTime();
+    timeout_elapsed += chTimeDiffX(timeout_last, now);
+    timeout_last = now;
     
-    /* Check if elapsed time exceeds timeout */
-    return elapsed >= timeout_ticks;
+    /* Check if elapsed time exceeds timeout (timeout_ms is at most
+     * BOOTLOADER_TIMEOUT_MAX_MS, no overflow) */
+    return timeout_elapsed >= (sysinterval_t)timeout_ms * (CH_CFG_ST_FREQUENCY / 1000U);
 }
 
 /**
@@ -132,8 +260,46 @@ void bootloader_timeout_disable(void)
  */
 void bootloader_timeout_enable(void)
 {
-    timeout_start = chVTGetSystemTime();
-    timeout_enabled = true;
+    bootloader_timeout_init();
+}
+
+/**
+ * @brief Check if the application check is still running
+ */
+bool bootloader_validation_pending(void)
+{
+    return app_check == APP_CHECK_PENDING;
+}
+
+/**
+ * @brief Validate application (background validation thread)
+ */
+void bootloader_validate_background(void)
+{
+    (void)bootloader_validate_app();
+}
+
+/**
+ * @brief Check if the installed application was fully checked
+ */
+bool bootloader_app_verified(void)
+{
+    return app_check == APP_CHECK_VALID && !app_trusted && !usb_dfu_app_modified();
+}
+
+/**
+ * @brief Check if DFU mode may be left for the application on timeout
+ * 
+ * Uses the result from entry or the background check, unless the
+ * application partition was written in this session.
+ */
+static bool bootloader_app_ready(void)
+{
+    if (usb_dfu_app_modified()) {
+        return bootloader_validate_app();
+    }
+    
+    return app_check == APP_CHECK_VALID;
 }
 
 /**
@@ -148,8 +314,13 @@ void bootloader_run(void)
     
     /* Main bootloader loop - process DFU commands until download completes */
     while (state == BOOTLOADER_STATE_UPDATING) {
-        /* Process USB DFU state machine and flash operations */
-        usb_dfu_process();
+        /* Process USB DFU state machine and flash operations, once the
+         * background check is done with the flash and key/value store
+         * (the host sees DNBUSY meanwhile) */
+        if (app_check != APP_CHECK_PENDING) {
+            (void)bootloader_kv();  /* Loads the boot measurements */
+            usb_dfu_process();
+        }
         
         /* Check if firmware download completed successfully */
         if (usb_dfu_download_complete()) {
@@ -160,24 +331,416 @@ void bootloader_run(void)
         /* Check timeout - if expired, try to jump to app */
         if (bootloader_timeout_expired()) {
             /* Timeout expired - try to jump to application */
-            if (bootloader_validate_app()) {
+            if (bootloader_app_ready()) {
                 /* Valid application exists, jump to it */
                 state = BOOTLOADER_STATE_IDLE;
                 break;
             }
-            /* No valid application - reset timeout and stay in bootloader */
+            /* No valid application (or check still running) - reset
+             * timeout and stay in bootloader */
             bootloader_timeout_reset();
         }
         
         /* Yield to ChibiOS scheduler - check every 10ms */
         chThdSleepMilliseconds(10);
     }
+    
+    /* Host-visible DFU start-up time (kernel start to first GETSTATUS) */
+    uint32_t ready_us;
+    kv_store_t *store = bootloader_kv();
+    if (usb_dfu_ready_time(&ready_us)) {
+        boot_stats.dfu_ready_us = ready_us;
+        if (store != NULL) {
+            (void)kv_set(store, KV_KEY_DFU_READY_US, (const uint8_t *)&ready_us, sizeof(ready_us));
+        }
+    }
 }
 
 /**
- * @brief Validate application firmware
+ * @brief Find TLV extension in application header
  */
-bool bootloader_validate_app(void)
+const uint8_t *bootloader_find_tlv(const app_header_t *header, uint8_t type, uint8_t *len)
+{
+    if (header->header_version < APP_HEADER_VERSION ||
+        header->header_size > APP_VECTOR_TABLE_OFFSET) {
+        return NULL;
+    }
+    
+    const uint8_t *base = (const uint8_t *)header;
+    uint32_t offset = APP_HEADER_SIZE;
+    
+    while (offset + 2 <= header->header_size) {
+        uint8_t tlv_type = base[offset];
+        uint8_t tlv_len = base[offset + 1];
+        
+        if (tlv_type == APP_TLV_END || tlv_type == 0xFF) {
+            break;
+        }
+        
+        if (offset + 2 + tlv_len > header->header_size) {
+            break;  /* Truncated entry */
+        }
+        
+        if (tlv_type == type) {
+            if (len != NULL) {
+                *len = tlv_len;
+            }
+            return &base[offset + 2];
+        }
+        
+        offset += 2 + tlv_len;
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Read a uint32_t value from the key/value store
+ */
+static void bootloader_kv_get_u32(uint16_t key, uint32_t *value)
+{
+    uint32_t data;
+    size_t len;
+    
+    if (kv_get(&kv, key, (uint8_t *)&data, sizeof(data), &len) == ERR_SUCCESS &&
+        len == sizeof(data)) {
+        *value = data;
+    }
+}
+
+/**
+ * @brief Get key/value store (initialized on first use)
+ */
+static kv_store_t *bootloader_kv(void)
+{
+    if (!kv_ready) {
+        if (kv_init(&kv) != ERR_SUCCESS) {
+            return NULL;
+        }
+        kv_ready = true;
+        
+        /* Measurements of earlier boots, unless already measured in this one */
+        if (boot_stats.signature_cycles == BOOT_STATS_NONE) {
+            bootloader_kv_get_u32(KV_KEY_SIGNATURE_CYCLES, &boot_stats.signature_cycles);
+        }
+        if (boot_stats.dfu_ready_us == BOOT_STATS_NONE) {
+            bootloader_kv_get_u32(KV_KEY_DFU_READY_US, &boot_stats.dfu_ready_us);
+        }
+    }
+    
+    return &kv;
+}
+
+/**
+ * @brief Drop the cached key/value store context
+ */
+void bootloader_kv_reload(void)
+{
+    kv_ready = false;
+}
+
+/**
+ * @brief Get the boot measurements
+ */
+void bootloader_boot_stats_get(boot_stats_t *stats)
+{
+    *stats = boot_stats;
+    
+    /* This boot's DFU start-up time once the host has polled the status */
+    (void)usb_dfu_ready_time(&stats->dfu_ready_us);
+}
+
+#ifdef USE_IMAGE_SIGNATURE
+static const uint8_t signature_public_key[ED25519_PUBLIC_KEY_SIZE] = IMAGE_SIGNATURE_PUBLIC_KEY;
+
+/**
+ * @brief Verify APP_TLV_SIGNATURE over the image digest
+ * 
+ * The cost of the check (CPU cycles, at tick resolution) is stored under
+ * KV_KEY_SIGNATURE_CYCLES.
+ */
+static bool bootloader_check_signature(const app_header_t *header,
+                                       const uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    uint8_t len;
+    const uint8_t *sig = bootloader_find_tlv(header, APP_TLV_SIGNATURE, &len);
+    if (sig == NULL || len != ED25519_SIGNATURE_SIZE) {
+        return false;
+    }
+    
+    /* TLV entries are unaligned, copy to RAM */
+    uint8_t signature[ED25519_SIGNATURE_SIZE];
+    memcpy(signature, sig, sizeof(signature));
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel();
+#endif
+    
+    systime_t start = chVTGetSystemTimeX();
+    bool valid = ed25519_verify(signature, digest, SHA256_DIGEST_SIZE, signature_public_key);
+    sysinterval_t elapsed = chVTTimeElapsedSinceX(start);
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel_restore();
+#endif
+    
+    uint32_t cycles = (uint32_t)TIME_I2US(elapsed) * (STM32_SYSCLK / 1000000U);
+    boot_stats.signature_cycles = cycles;
+    
+    kv_store_t *store = bootloader_kv();
+    if (store != NULL) {
+        (void)kv_set(store, KV_KEY_SIGNATURE_CYCLES, (const uint8_t *)&cycles, sizeof(cycles));
+    }
+    
+    return valid;
+}
+#endif /* USE_IMAGE_SIGNATURE */
+
+#ifdef USE_PARTIAL_BOOT_CHECK
+/**
+ * @brief Build per-page CRC32 table of the installed image and store it
+ * 
+ * @return 0 on success, negative error code otherwise
+ */
+static int bootloader_build_page_table(const app_header_t *header)
+{
+    page_table_t table;
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel();
+#endif
+    
+    size_t len = page_table_build(&table, header->size, header->crc32);
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel_restore();
+#endif
+    
+    return image_store_write(IMAGE_STORE_PAGE_TABLE, (const uint8_t *)&table, len);
+}
+
+/**
+ * @brief Check the vector table page and BOOT_CHECK_PAGES pages in rotation
+ * 
+ * The table must belong to the header (size, CRC32) and its entries must
+ * combine to the image CRC32, so a stale or damaged table is never trusted.
+ * 
+ * @return true if all checked pages match, false if there is no usable
+ *         table or a page does not match (full check required)
+ */
+static bool bootloader_check_pages(const app_header_t *header)
+{
+    page_table_t table;
+    size_t table_len;
+    
+    if (image_store_read(IMAGE_STORE_PAGE_TABLE, (uint8_t *)&table, sizeof(table), &table_len) != ERR_SUCCESS ||
+        !page_table_valid(&table, table_len, header->size, header->crc32)) {
+        return false;
+    }
+    
+    /* Rotation over pages 1..n-1, page 0 (vector table) is always checked */
+    kv_store_t *store = bootloader_kv();
+    uint8_t cursor = 0;
+    size_t cursor_len;
+    if (store == NULL || kv_get(store, KV_KEY_CHECK_CURSOR, &cursor, sizeof(cursor), &cursor_len) != ERR_SUCCESS ||
+        cursor_len != sizeof(cursor)) {
+        cursor = 1;
+    }
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel();
+#endif
+    
+    bool match = page_table_check(&table, &cursor, BOOT_CHECK_PAGES);
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel_restore();
+#endif
+    
+    if (match && store != NULL) {
+        (void)kv_set(store, KV_KEY_CHECK_CURSOR, &cursor, sizeof(cursor));
+    }
+    
+    return match;
+}
+#endif /* USE_PARTIAL_BOOT_CHECK */
+
+/**
+ * @brief Store verified-image record for the installed application
+ */
+int bootloader_record_image(const uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    const app_header_t *header = (const app_header_t *)APP_BASE;
+    
+    if (header->magic != APP_HEADER_MAGIC ||
+        header->size == 0 || header->size > APP_MAX_SIZE - APP_VECTOR_TABLE_OFFSET) {
+        return ERR_INVALID_HEADER;
+    }
+    
+    uint8_t len;
+    const uint8_t *expected = bootloader_find_tlv(header, APP_TLV_SHA256, &len);
+    if (expected != NULL &&
+        (len != SHA256_DIGEST_SIZE || memcmp(expected, digest, SHA256_DIGEST_SIZE) != 0)) {
+        return ERR_INVALID_CRC;
+    }
+    
+    image_record_t record;
+    record.size = header->size;
+    record.crc32 = header->crc32;
+    memcpy(record.sha256, digest, SHA256_DIGEST_SIZE);
+    record.flags = 0;
+    
+#ifdef USE_IMAGE_SIGNATURE
+    if (expected == NULL || !bootloader_check_signature(header, digest)) {
+        return ERR_INVALID_SIGNATURE;
+    }
+    record.flags |= IMAGE_RECORD_SIGNED;
+#endif
+    
+#ifdef USE_PARTIAL_BOOT_CHECK
+    /* Table first: if the record fills the page, only the table is lost
+     * (rebuilt after the next full check) */
+    (void)bootloader_build_page_table(header);
+#endif
+    
+    return image_store_write(IMAGE_STORE_RECORD, (const uint8_t *)&record, sizeof(record));
+}
+
+/**
+ * @brief Forget the verified-image record and page table
+ */
+int bootloader_forget_image(void)
+{
+    return image_store_erase();
+}
+
+/**
+ * @brief Check image digest against header (APP_TLV_SHA256)
+ * 
+ * Compares the verified-image record when it matches the header. Without a
+ * matching record (e.g. image flashed over SWD) the image is hashed once
+ * and the record is stored. With USE_IMAGE_SIGNATURE the digest is required
+ * and the record must carry IMAGE_RECORD_SIGNED.
+ */
+static bool bootloader_check_digest(const app_header_t *header)
+{
+    uint8_t len;
+    const uint8_t *expected = bootloader_find_tlv(header, APP_TLV_SHA256, &len);
+    
+    /* No digest in header: CRC32 only */
+    if (expected == NULL) {
+#ifdef USE_IMAGE_SIGNATURE
+        return false;
+#else
+        return true;
+#endif
+    }
+    
+    if (len != SHA256_DIGEST_SIZE) {
+        return false;
+    }
+    
+    image_record_t record;
+    size_t record_len;
+    
+    if (image_store_read(IMAGE_STORE_RECORD, (uint8_t *)&record, sizeof(record), &record_len) == ERR_SUCCESS &&
+        record_len == sizeof(record) &&
+        record.size == header->size &&
+        record.crc32 == header->crc32 &&
+        memcmp(record.sha256, expected, SHA256_DIGEST_SIZE) == 0) {
+#ifdef USE_IMAGE_SIGNATURE
+        if ((record.flags & IMAGE_RECORD_SIGNED) != 0) {
+            return true;
+        }
+#else
+        return true;
+#endif
+    }
+    
+    /* No matching record: hash image once */
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel();
+#endif
+    
+    sha256_calculate((const uint8_t *)(APP_BASE + APP_VECTOR_TABLE_OFFSET), header->size, digest);
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel_restore();
+#endif
+    
+    if (memcmp(digest, expected, SHA256_DIGEST_SIZE) != 0) {
+        return false;
+    }
+    
+    /* Best effort: a missing record only costs a rehash on next boot */
+    int ret = bootloader_record_image(digest);
+    
+    return ret != ERR_INVALID_CRC && ret != ERR_INVALID_SIGNATURE;
+}
+
+/**
+ * @brief Check header version 2 fields and TLV constraints
+ */
+static bool bootloader_check_header(const app_header_t *header)
+{
+    /* Version 1: no extension area */
+    if (header->header_version < APP_HEADER_VERSION) {
+        return true;
+    }
+    
+    if (header->header_size < APP_HEADER_SIZE ||
+        header->header_size > APP_VECTOR_TABLE_OFFSET) {
+        return false;
+    }
+    
+    uint32_t crc = crc32_calculate((const uint8_t *)header + APP_HEADER_SIZE,
+                                   header->header_size - APP_HEADER_SIZE);
+    if (crc != header->header_crc) {
+        return false;
+    }
+    
+    /* Image requires a newer bootloader */
+    uint8_t len;
+    const uint8_t *value = bootloader_find_tlv(header, APP_TLV_MIN_BL_VERSION, &len);
+    if (value != NULL && len == 4) {
+        uint32_t min_version = (uint32_t)value[0] | ((uint32_t)value[1] << 8) |
+                               ((uint32_t)value[2] << 16) | ((uint32_t)value[3] << 24);
+        if (min_version > BOOTLOADER_VERSION) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Check for an image check skip request (boot mailbox)
+ * 
+ * The request names the CRC32 of the image the application has verified
+ * itself, so it never applies to another image. A DFU session that wrote
+ * the application partition (possibly cut short) cancels it.
+ */
+static bool bootloader_skip_requested(const app_header_t *header)
+{
+#ifdef USE_IMAGE_SIGNATURE
+    /* Signed images are always checked */
+    (void)header;
+    return false;
+#else
+    uint16_t action = mailbox_action();
+    
+    return (action == MAILBOX_ACTION_SKIP_CHECK || action == MAILBOX_ACTION_DATA_UPDATE) &&
+           mailbox_arg() == header->crc32 &&
+           !usb_dfu_app_modified();
+#endif
+}
+
+/**
+ * @brief Check application header and image
+ */
+static bool bootloader_check_app(void)
 {
     const app_header_t *header = (const app_header_t *)APP_BASE;
     
@@ -186,11 +749,33 @@ bool bootloader_validate_app(void)
         return false;
     }
     
-    /* Check size */
-    if (header->size == 0 || header->size > APP_MAX_SIZE) {
+    /* Check size (image starts at the vector table) */
+    if (header->size == 0 || header->size > APP_MAX_SIZE - APP_VECTOR_TABLE_OFFSET) {
         return false;
     }
     
+    /* Check header extension (version 2+) */
+    if (!bootloader_check_header(header)) {
+        return false;
+    }
+    
+    /* Image just verified by the application itself */
+    app_trusted = bootloader_skip_requested(header);
+    if (app_trusted) {
+        return true;
+    }
+    
+#ifdef USE_PARTIAL_BOOT_CHECK
+    /* Vector table page and a rotating subset of pages */
+    if (bootloader_check_pages(header)) {
+        return bootloader_check_digest(header);
+    }
+#endif
+    
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel();
+#endif
+    
     /* Verify CRC32
      * CRC is calculated over firmware starting at vector table (0x08004100)
      * NOT from 0x08004020 (old layout)
@@ -200,13 +785,41 @@ bool bootloader_validate_app(void)
         header->size
     );
     
+#ifdef USE_BOOT_CLOCK_BOOST
+    bootloader_flash_accel_restore();
+#endif
+    
     if (calc_crc != header->crc32) {
         return false;
     }
     
+    /* Compare SHA-256 digest (record lookup, hashed only once per image) */
+    if (!bootloader_check_digest(header)) {
+        return false;
+    }
+    
+#ifdef USE_PARTIAL_BOOT_CHECK
+    /* Full check passed without a usable table: rebuild it */
+    (void)bootloader_build_page_table(header);
+#endif
+    
     return true;
 }
 
+/**
+ * @brief Validate application firmware
+ */
+bool bootloader_validate_app(void)
+{
+    /* Once per boot (the partial check cursor advances once), again only
+     * after the application partition was written */
+    if (app_check == APP_CHECK_PENDING || usb_dfu_app_modified()) {
+        app_check = bootloader_check_app() ? APP_CHECK_VALID : APP_CHECK_INVALID;
+    }
+    
+    return app_check == APP_CHECK_VALID;
+}
+
 /**
  * @brief Jump to application firmware
  */
@@ -217,9 +830,26 @@ void bootloader_jump_to_app(void)
         return;  /* Invalid application, stay in bootloader */
     }
     
+    /* Tell the application how it was started */
+    if (app_trusted) {
+        mailbox_set_result(MAILBOX_RESULT_TRUSTED);
+    } else if (mailbox_action() == MAILBOX_ACTION_BOOT_SLOT) {
+        mailbox_set_result(MAILBOX_RESULT_UNSUPPORTED);  /* Single application slot */
+    } else {
+        mailbox_set_result(MAILBOX_RESULT_VALIDATED);
+    }
+    
     /* Disable interrupts */
     __disable_irq();
     
+#ifdef USE_BOOT_CLOCK_BOOST
+    /* Hand over reset-default clocks, unless the application opted out */
+    const app_header_t *header = (const app_header_t *)APP_BASE;
+    if ((header->flags & APP_FLAG_WARM_HANDOFF) == 0) {
+        bootloader_clock_reset_default();
+    }
+#endif
+    
     /* Calculate vector table address
      * ARM Cortex-M0+ requires 256-byte alignment for vector tables
      * Vector table is at APP_BASE + 0x100 (256 bytes from start)
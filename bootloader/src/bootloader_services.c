@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file bootloader_services.c
+ * @brief Bootloader service table exported to applications
+ * 
+ * The table is placed in the .bl_services section, which the linker script
+ * locates at BL_SERVICES_ADDR (last 256 bytes of bootloader flash).
+ */
+
+#include "bootloader_services.h"
+#include "bootloader.h"
+#include "config.h"
+#include "crc32.h"
+#include "flash_ops.h"
+#include "kv_store.h"
+
+/**
+ * @brief Erase flash pages (application region only)
+ */
+static int svc_flash_erase_pages(uint32_t addr, size_t len)
+{
+    if ((addr - FLASH_BASE_ADDRESS) % FLASH_PAGE_SIZE != 0) {
+        return ERR_INVALID_ADDRESS;
+    }
+    
+    if (!flash_is_app_region(addr, len)) {
+        return ERR_INVALID_ADDRESS;
+    }
+    
+    return flash_erase_pages(addr, len);
+}
+
+/**
+ * @brief Write data to flash (application region only)
+ */
+static int svc_flash_write(uint32_t addr, const uint8_t *data, size_t len)
+{
+    if (addr % FLASH_WRITE_SIZE != 0) {
+        return ERR_INVALID_ADDRESS;
+    }
+    
+    if (!flash_is_app_region(addr, len)) {
+        return ERR_INVALID_ADDRESS;
+    }
+    
+    return flash_write(addr, data, len);
+}
+
+/**
+ * @brief Write value (keys reserved for the bootloader are rejected)
+ */
+static int svc_kv_set(kv_store_t *kv, uint16_t key, const uint8_t *data, size_t len)
+{
+    if (key >= KV_KEY_RESERVED_FIRST) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    return kv_set(kv, key, data, len);
+}
+
+/**
+ * @brief Delete value (keys reserved for the bootloader are rejected)
+ */
+static int svc_kv_delete(kv_store_t *kv, uint16_t key)
+{
+    if (key >= KV_KEY_RESERVED_FIRST) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    return kv_delete(kv, key);
+}
+
+/**
+ * @brief Service table instance
+ */
+__attribute__((section(".bl_services")))
+__attribute__((used))
+const bl_services_t bl_services = {
+    .magic = BL_SERVICES_MAGIC,
+    .version = BL_SERVICES_VERSION,
+    .size = sizeof(bl_services_t),
+    .get_version = bootloader_get_version,
+    .crc32_init = crc32_init,
+    .crc32_update = crc32_update,
+    .crc32_finalize = crc32_finalize,
+    .flash_unlock = flash_unlock,
+    .flash_lock = flash_lock,
+    .flash_erase_pages = svc_flash_erase_pages,
+    .flash_write = svc_flash_write,
+    .kv_init = kv_init,
+    .kv_get = kv_get,
+    .kv_set = svc_kv_set,
+    .kv_delete = svc_kv_delete,
+    .crc32_combine = crc32_combine
+};
+
+_Static_assert(sizeof(bl_services_t) <= BL_SERVICES_SIZE,
+               "Service table does not fit in reserved flash");
@@ -0,0 +1,644 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file ed25519.c
+ * @brief Ed25519 signature verification for Cortex-M0+
+ * 
+ * Field arithmetic follows TweetNaCl (public domain): GF(2^255-19) elements
+ * as 16 limbs of 16 bits, so every limb product is a 16x16 bit multiply.
+ * 
+ * Verification computes [s]B + [h](-A) with a single joint ladder
+ * (Straus-Shamir): one doubling and one addition of a table entry
+ * {O, B, -A, B-A} per scalar bit, selected in constant time. Compared to two
+ * separate Montgomery ladders this is roughly half the field multiplies.
+ */
+
+#include "ed25519.h"
+#include <string.h>
+
+typedef int64_t gf[16];
+
+/*===========================================================================*/
+/* SHA-512 (only used for the challenge hash)                                */
+/*===========================================================================*/
+
+typedef struct {
+    uint64_t state[8];
+    uint32_t count;
+    uint8_t buffer[128];
+} sha512_ctx_t;
+
+static const uint64_t sha512_k[80] = {
+    0x428A2F98D728AE22ULL, 0x7137449123EF65CDULL, 0xB5C0FBCFEC4D3B2FULL, 0xE9B5DBA58189DBBCULL,
+    0x3956C25BF348B538ULL, 0x59F111F1B605D019ULL, 0x923F82A4AF194F9BULL, 0xAB1C5ED5DA6D8118ULL,
+    0xD807AA98A3030242ULL, 0x12835B0145706FBEULL, 0x243185BE4EE4B28CULL, 0x550C7DC3D5FFB4E2ULL,
+    0x72BE5D74F27B896FULL, 0x80DEB1FE3B1696B1ULL, 0x9BDC06A725C71235ULL, 0xC19BF174CF692694ULL,
+    0xE49B69C19EF14AD2ULL, 0xEFBE4786384F25E3ULL, 0x0FC19DC68B8CD5B5ULL, 0x240CA1CC77AC9C65ULL,
+    0x2DE92C6F592B0275ULL, 0x4A7484AA6EA6E483ULL, 0x5CB0A9DCBD41FBD4ULL, 0x76F988DA831153B5ULL,
+    0x983E5152EE66DFABULL, 0xA831C66D2DB43210ULL, 0xB00327C898FB213FULL, 0xBF597FC7BEEF0EE4ULL,
+    0xC6E00BF33DA88FC2ULL, 0xD5A79147930AA725ULL, 0x06CA6351E003826FULL, 0x142929670A0E6E70ULL,
+    0x27B70A8546D22FFCULL, 0x2E1B21385C26C926ULL, 0x4D2C6DFC5AC42AEDULL, 0x53380D139D95B3DFULL,
+    0x650A73548BAF63DEULL, 0x766A0ABB3C77B2A8ULL, 0x81C2C92E47EDAEE6ULL, 0x92722C851482353BULL,
+    0xA2BFE8A14CF10364ULL, 0xA81A664BBC423001ULL, 0xC24B8B70D0F89791ULL, 0xC76C51A30654BE30ULL,
+    0xD192E819D6EF5218ULL, 0xD69906245565A910ULL, 0xF40E35855771202AULL, 0x106AA07032BBD1B8ULL,
+    0x19A4C116B8D2D0C8ULL, 0x1E376C085141AB53ULL, 0x2748774CDF8EEB99ULL, 0x34B0BCB5E19B48A8ULL,
+    0x391C0CB3C5C95A63ULL, 0x4ED8AA4AE3418ACBULL, 0x5B9CCA4F7763E373ULL, 0x682E6FF3D6B2B8A3ULL,
+    0x748F82EE5DEFB2FCULL, 0x78A5636F43172F60ULL, 0x84C87814A1F0AB72ULL, 0x8CC702081A6439ECULL,
+    0x90BEFFFA23631E28ULL, 0xA4506CEBDE82BDE9ULL, 0xBEF9A3F7B2C67915ULL, 0xC67178F2E372532BULL,
+    0xCA273ECEEA26619CULL, 0xD186B8C721C0C207ULL, 0xEADA7DD6CDE0EB1EULL, 0xF57D4F7FEE6ED178ULL,
+    0x06F067AA72176FBAULL, 0x0A637DC5A2C898A6ULL, 0x113F9804BEF90DAEULL, 0x1B710B35131C471BULL,
+    0x28DB77F523047D84ULL, 0x32CAAB7B40C72493ULL, 0x3C9EBE0A15C9BEBCULL, 0x431D67C49C100D4CULL,
+    0x4CC5D4BECB3E42B6ULL, 0x597F299CFC657E2AULL, 0x5FCB6FAB3AD6FAECULL, 0x6C44198C4A475817ULL
+};
+
+#define ROR64(x, n)  (((x) >> (n)) | ((x) << (64 - (n))))
+
+/**
+ * @brief Process one 128-byte block
+ */
+static void sha512_transform(uint64_t state[8], const uint8_t *block)
+{
+    uint64_t w[16];
+    uint64_t v[8];
+    
+    for (int i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (int j = 0; j < 8; j++) {
+            w[i] = (w[i] << 8) | block[8 * i + j];
+        }
+    }
+    
+    for (int i = 0; i < 8; i++) {
+        v[i] = state[i];
+    }
+    
+    for (int i = 0; i < 80; i++) {
+        if (i >= 16) {
+            uint64_t w2 = w[(i - 2) & 15];
+            uint64_t w15 = w[(i - 15) & 15];
+            w[i & 15] += (ROR64(w2, 19) ^ ROR64(w2, 61) ^ (w2 >> 6)) + w[(i - 7) & 15] +
+                         (ROR64(w15, 1) ^ ROR64(w15, 8) ^ (w15 >> 7));
+        }
+        
+        uint64_t t1 = v[7] + (ROR64(v[4], 14) ^ ROR64(v[4], 18) ^ ROR64(v[4], 41)) +
+                      (v[6] ^ (v[4] & (v[5] ^ v[6]))) + sha512_k[i] + w[i & 15];
+        uint64_t t2 = (ROR64(v[0], 28) ^ ROR64(v[0], 34) ^ ROR64(v[0], 39)) +
+                      ((v[0] & v[1]) | (v[2] & (v[0] | v[1])));
+        
+        v[7] = v[6]; v[6] = v[5]; v[5] = v[4]; v[4] = v[3] + t1;
+        v[3] = v[2]; v[2] = v[1]; v[1] = v[0]; v[0] = t1 + t2;
+    }
+    
+    for (int i = 0; i < 8; i++) {
+        state[i] += v[i];
+    }
+}
+
+static void sha512_init(sha512_ctx_t *ctx)
+{
+    static const uint64_t iv[8] = {
+        0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL, 0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+        0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL, 0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL
+    };
+    
+    memcpy(ctx->state, iv, sizeof(iv));
+    ctx->count = 0;
+}
+
+static void sha512_update(sha512_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    while (len > 0) {
+        size_t fill = ctx->count % 128;
+        size_t n = 128 - fill;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(&ctx->buffer[fill], data, n);
+        ctx->count += n;
+        data += n;
+        len -= n;
+        if (fill + n == 128) {
+            sha512_transform(ctx->state, ctx->buffer);
+        }
+    }
+}
+
+static void sha512_final(sha512_ctx_t *ctx, uint8_t digest[64])
+{
+    size_t fill = ctx->count % 128;
+    uint32_t bits_hi = ctx->count >> 29;
+    uint32_t bits_lo = ctx->count << 3;
+    
+    ctx->buffer[fill++] = 0x80;
+    if (fill > 128 - 16) {
+        memset(&ctx->buffer[fill], 0, 128 - fill);
+        sha512_transform(ctx->state, ctx->buffer);
+        fill = 0;
+    }
+    memset(&ctx->buffer[fill], 0, 128 - fill);
+    
+    for (int i = 0; i < 4; i++) {
+        ctx->buffer[120 + i] = (uint8_t)(bits_hi >> (24 - 8 * i));
+        ctx->buffer[124 + i] = (uint8_t)(bits_lo >> (24 - 8 * i));
+    }
+    sha512_transform(ctx->state, ctx->buffer);
+    
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            digest[8 * i + j] = (uint8_t)(ctx->state[i] >> (56 - 8 * j));
+        }
+    }
+}
+
+/*===========================================================================*/
+/* Field arithmetic GF(2^255-19)                                             */
+/*===========================================================================*/
+
+static const gf gf0 = {0};
+static const gf gf1 = {1};
+
+/* Curve constant 2*d */
+static const gf D2 = {
+    0xF159, 0x26B2, 0x9B94, 0xEBD6, 0xB156, 0x8283, 0x149A, 0x00E0,
+    0xD130, 0xEEF3, 0x80F2, 0x198E, 0xFCE7, 0x56DF, 0xD9DC, 0x2406
+};
+
+/* Curve constant d */
+static const gf D = {
+    0x78A3, 0x1359, 0x4DCA, 0x75EB, 0xD8AB, 0x4141, 0x0A4D, 0x0070,
+    0xE898, 0x7779, 0x4079, 0x8CC7, 0xFE73, 0x2B6F, 0x6CEE, 0x5203
+};
+
+/* Base point coordinates */
+static const gf BX = {
+    0xD51A, 0x8F25, 0x2D60, 0xC956, 0xA7B2, 0x9525, 0xC760, 0x692C,
+    0xDC5C, 0xFDD6, 0xE231, 0xC0A4, 0x53FE, 0xCD6E, 0x36D3, 0x2169
+};
+static const gf BY = {
+    0x6658, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666,
+    0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666, 0x6666
+};
+
+/* sqrt(-1) */
+static const gf I = {
+    0xA0B0, 0x4A0E, 0x1B27, 0xC4EE, 0xE478, 0xAD2F, 0x1806, 0x2F43,
+    0xD7A7, 0x3DFB, 0x0099, 0x2B4D, 0xDF0B, 0x4FC1, 0x2480, 0x2B83
+};
+
+static void set25519(gf r, const gf a)
+{
+    for (int i = 0; i < 16; i++) {
+        r[i] = a[i];
+    }
+}
+
+static void car25519(gf o)
+{
+    for (int i = 0; i < 16; i++) {
+        int64_t c;
+        o[i] += (1LL << 16);
+        c = o[i] >> 16;
+        o[(i + 1) * (i < 15)] += c - 1 + 37 * (c - 1) * (i == 15);
+        o[i] -= c << 16;
+    }
+}
+
+/* Conditional swap (b = 1) in constant time */
+static void sel25519(gf p, gf q, int b)
+{
+    int64_t c = ~(b - 1);
+    
+    for (int i = 0; i < 16; i++) {
+        int64_t t = c & (p[i] ^ q[i]);
+        p[i] ^= t;
+        q[i] ^= t;
+    }
+}
+
+/* Conditional move (b = 1) in constant time */
+static void cmov25519(gf r, const gf a, int b)
+{
+    int64_t c = ~(b - 1);
+    
+    for (int i = 0; i < 16; i++) {
+        r[i] ^= c & (r[i] ^ a[i]);
+    }
+}
+
+static void pack25519(uint8_t *o, const gf n)
+{
+    gf m, t;
+    
+    set25519(t, n);
+    car25519(t);
+    car25519(t);
+    car25519(t);
+    
+    for (int j = 0; j < 2; j++) {
+        m[0] = t[0] - 0xFFED;
+        for (int i = 1; i < 15; i++) {
+            m[i] = t[i] - 0xFFFF - ((m[i - 1] >> 16) & 1);
+            m[i - 1] &= 0xFFFF;
+        }
+        m[15] = t[15] - 0x7FFF - ((m[14] >> 16) & 1);
+        int b = (int)((m[15] >> 16) & 1);
+        m[14] &= 0xFFFF;
+        sel25519(t, m, 1 - b);
+    }
+    
+    for (int i = 0; i < 16; i++) {
+        o[2 * i] = (uint8_t)(t[i] & 0xFF);
+        o[2 * i + 1] = (uint8_t)(t[i] >> 8);
+    }
+}
+
+/* Constant time compare, 0 if equal */
+static int verify32(const uint8_t *x, const uint8_t *y)
+{
+    uint32_t d = 0;
+    
+    for (int i = 0; i < 32; i++) {
+        d |= x[i] ^ y[i];
+    }
+    
+    return (int)((1 & ((d - 1) >> 8)) - 1);
+}
+
+static int neq25519(const gf a, const gf b)
+{
+    uint8_t c[32], d[32];
+    
+    pack25519(c, a);
+    pack25519(d, b);
+    return verify32(c, d);
+}
+
+static uint8_t par25519(const gf a)
+{
+    uint8_t d[32];
+    
+    pack25519(d, a);
+    return d[0] & 1;
+}
+
+static void unpack25519(gf o, const uint8_t *n)
+{
+    for (int i = 0; i < 16; i++) {
+        o[i] = n[2 * i] + ((int64_t)n[2 * i + 1] << 8);
+    }
+    o[15] &= 0x7FFF;
+}
+
+static void A(gf o, const gf a, const gf b)
+{
+    for (int i = 0; i < 16; i++) {
+        o[i] = a[i] + b[i];
+    }
+}
+
+static void Z(gf o, const gf a, const gf b)
+{
+    for (int i = 0; i < 16; i++) {
+        o[i] = a[i] - b[i];
+    }
+}
+
+static void M(gf o, const gf a, const gf b)
+{
+    int64_t t[31];
+    
+    for (int i = 0; i < 31; i++) {
+        t[i] = 0;
+    }
+    
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 16; j++) {
+            t[i + j] += a[i] * b[j];
+        }
+    }
+    
+    for (int i = 0; i < 15; i++) {
+        t[i] += 38 * t[i + 16];
+    }
+    
+    for (int i = 0; i < 16; i++) {
+        o[i] = t[i];
+    }
+    
+    car25519(o);
+    car25519(o);
+}
+
+static void S(gf o, const gf a)
+{
+    M(o, a, a);
+}
+
+static void inv25519(gf o, const gf i)
+{
+    gf c;
+    
+    set25519(c, i);
+    for (int a = 253; a >= 0; a--) {
+        S(c, c);
+        if (a != 2 && a != 4) {
+            M(c, c, i);
+        }
+    }
+    set25519(o, c);
+}
+
+static void pow2523(gf o, const gf i)
+{
+    gf c;
+    
+    set25519(c, i);
+    for (int a = 250; a >= 0; a--) {
+        S(c, c);
+        if (a != 1) {
+            M(c, c, i);
+        }
+    }
+    set25519(o, c);
+}
+
+/*===========================================================================*/
+/* Group operations (extended twisted Edwards coordinates X, Y, Z, T)        */
+/*===========================================================================*/
+
+/* p = p + q (complete, unified addition) */
+static void point_add(gf p[4], const gf q[4])
+{
+    gf a, b, c, d, t, e, f, g, h;
+    
+    Z(a, p[1], p[0]);
+    Z(t, q[1], q[0]);
+    M(a, a, t);
+    A(b, p[0], p[1]);
+    A(t, q[0], q[1]);
+    M(b, b, t);
+    M(c, p[3], q[3]);
+    M(c, c, D2);
+    M(d, p[2], q[2]);
+    A(d, d, d);
+    Z(e, b, a);
+    Z(f, d, c);
+    A(g, d, c);
+    A(h, b, a);
+    
+    M(p[0], e, f);
+    M(p[1], h, g);
+    M(p[2], g, f);
+    M(p[3], e, h);
+}
+
+/* p = 2p (dbl-2008-hwcd, a = -1: 4M + 4S instead of 9M) */
+static void point_double(gf p[4])
+{
+    gf a, b, c, e, f, g, h;
+    
+    S(a, p[0]);
+    S(b, p[1]);
+    S(c, p[2]);
+    A(c, c, c);
+    A(e, p[0], p[1]);
+    S(e, e);
+    Z(e, e, a);
+    Z(e, e, b);
+    Z(g, b, a);          /* G = -A + B */
+    Z(f, g, c);          /* F = G - C */
+    Z(h, gf0, a);
+    Z(h, h, b);          /* H = -A - B */
+    
+    M(p[0], e, f);
+    M(p[1], g, h);
+    M(p[3], e, h);
+    M(p[2], f, g);
+}
+
+static void point_pack(uint8_t *r, gf p[4])
+{
+    gf tx, ty, zi;
+    
+    inv25519(zi, p[2]);
+    M(tx, p[0], zi);
+    M(ty, p[1], zi);
+    pack25519(r, ty);
+    r[31] ^= par25519(tx) << 7;
+}
+
+/* Decode point and negate, 0 on success */
+static int point_unpack_neg(gf r[4], const uint8_t p[32])
+{
+    gf t, chk, num, den, den2, den4, den6;
+    
+    set25519(r[2], gf1);
+    unpack25519(r[1], p);
+    S(num, r[1]);
+    M(den, num, D);
+    Z(num, num, r[2]);
+    A(den, r[2], den);
+    
+    S(den2, den);
+    S(den4, den2);
+    M(den6, den4, den2);
+    M(t, den6, num);
+    M(t, t, den);
+    
+    pow2523(t, t);
+    M(t, t, num);
+    M(t, t, den);
+    M(t, t, den);
+    M(r[0], t, den);
+    
+    S(chk, r[0]);
+    M(chk, chk, den);
+    if (neq25519(chk, num)) {
+        M(r[0], r[0], I);
+    }
+    
+    S(chk, r[0]);
+    M(chk, chk, den);
+    if (neq25519(chk, num)) {
+        return -1;
+    }
+    
+    if (par25519(r[0]) == (p[31] >> 7)) {
+        Z(r[0], gf0, r[0]);
+    }
+    
+    M(r[3], r[0], r[1]);
+    return 0;
+}
+
+/*===========================================================================*/
+/* Scalar arithmetic modulo L                                                */
+/*===========================================================================*/
+
+/* Group order L = 2^252 + 27742317777372353535851937790883648493 */
+static const int64_t L[32] = {
+    0xED, 0xD3, 0xF5, 0x5C, 0x1A, 0x63, 0x12, 0x58,
+    0xD6, 0x9C, 0xF7, 0xA2, 0xDE, 0xF9, 0xDE, 0x14,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0x10
+};
+
+static void mod_l(uint8_t *r, int64_t x[64])
+{
+    int64_t carry;
+    int i, j;
+    
+    for (i = 63; i >= 32; --i) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; ++j) {
+            x[j] += carry - 16 * x[i] * L[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry * 256;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+    
+    carry = 0;
+    for (j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * L[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    
+    for (j = 0; j < 32; j++) {
+        x[j] -= carry * L[j];
+    }
+    
+    for (i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        r[i] = (uint8_t)(x[i] & 255);
+    }
+}
+
+/* Reduce 64-byte hash modulo L into 32 bytes */
+static void reduce_l(uint8_t r[32], const uint8_t h[64])
+{
+    int64_t x[64];
+    
+    for (int i = 0; i < 64; i++) {
+        x[i] = h[i];
+    }
+    
+    mod_l(r, x);
+}
+
+/* Check s < L (rejects malleable signatures) */
+static bool scalar_is_canonical(const uint8_t s[32])
+{
+    uint32_t borrow = 0;
+    
+    /* s - L, borrow out means s < L */
+    for (int i = 0; i < 32; i++) {
+        uint32_t diff = (uint32_t)s[i] - (uint32_t)L[i] - borrow;
+        borrow = (diff >> 8) & 1;
+    }
+    
+    return borrow == 1;
+}
+
+/*===========================================================================*/
+/* Verification                                                              */
+/*===========================================================================*/
+
+/* Work memory (kept off the stack, the main thread stack is small) */
+static gf table[4][4];  /* O, B, -A, B - A */
+static gf acc[4];
+static gf sel[4];
+
+/**
+ * @brief Verify Ed25519 signature
+ */
+bool ed25519_verify(const uint8_t sig[ED25519_SIGNATURE_SIZE],
+                    const uint8_t *msg, size_t len,
+                    const uint8_t public_key[ED25519_PUBLIC_KEY_SIZE])
+{
+    uint8_t hash[64];
+    uint8_t h[32];
+    uint8_t check[32];
+    sha512_ctx_t sha;
+    
+    if (!scalar_is_canonical(sig + 32)) {
+        return false;
+    }
+    
+    /* table[2] = -A */
+    if (point_unpack_neg(table[2], public_key) != 0) {
+        return false;
+    }
+    
+    /* h = SHA-512(R || A || M) mod L */
+    sha512_init(&sha);
+    sha512_update(&sha, sig, 32);
+    sha512_update(&sha, public_key, ED25519_PUBLIC_KEY_SIZE);
+    sha512_update(&sha, msg, len);
+    sha512_final(&sha, hash);
+    reduce_l(h, hash);
+    
+    /* table[0] = O, table[1] = B, table[3] = B - A */
+    set25519(table[0][0], gf0);
+    set25519(table[0][1], gf1);
+    set25519(table[0][2], gf1);
+    set25519(table[0][3], gf0);
+    set25519(table[1][0], BX);
+    set25519(table[1][1], BY);
+    set25519(table[1][2], gf1);
+    M(table[1][3], BX, BY);
+    for (int i = 0; i < 4; i++) {
+        set25519(table[3][i], table[1][i]);
+    }
+    point_add(table[3], table[2]);
+    
+    /* acc = [s]B + [h](-A), one double and one add per bit */
+    for (int i = 0; i < 4; i++) {
+        set25519(acc[i], table[0][i]);
+    }
+    
+    for (int bit = 255; bit >= 0; bit--) {
+        int s_bit = (sig[32 + bit / 8] >> (bit & 7)) & 1;
+        int h_bit = (h[bit / 8] >> (bit & 7)) & 1;
+        uint32_t idx = (uint32_t)(s_bit | (h_bit << 1));
+        
+        point_double(acc);
+        
+        for (uint32_t k = 0; k < 4; k++) {
+            int match = (int)((((idx ^ k) - 1) >> 31) & 1);
+            for (int c = 0; c < 4; c++) {
+                cmov25519(sel[c], table[k][c], match);
+            }
+        }
+        point_add(acc, (const gf *)sel);
+    }
+    
+    point_pack(check, acc);
+    
+    return verify32(check, sig) == 0;
+}
@@ -196,7 +196,7 @@ int flash_write(uint32_t addr, const uint8_t *data, size_t len)
     }
     
     /* Write double-word (8 bytes) by double-word */
-    for (size_t i = 0; i < len; i += 8) {
+    for (size_t i = 0; i < len; i += FLASH_WRITE_SIZE) {
         uint32_t word1, word2;
         
         /* Build first word from bytes (safe for unaligned access) */
@@ -246,20 +246,11 @@ int flash_write(uint32_t addr, const uint8_t *data, size_t len)
  */
 bool flash_is_app_region(uint32_t addr, size_t len)
 {
-    if (addr < APP_BASE || addr >= FLASH_END) {
+    if (addr < APP_BASE || addr >= APP_END) {
         return false;
     }
     
-    if (addr + len > FLASH_END) {
-        return false;
-    }
-    
-    /* Ensure not writing to bootloader */
-    if (addr < APP_BASE) {
-        return false;
-    }
-    
-    return true;
+    return len <= APP_END - addr;
 }
 
 
@@ -0,0 +1,226 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file image_store.c
+ * @brief Bootloader-private flash page for verified-image state
+ * 
+ * Holds what the bootloader learned about the installed image (verified-image
+ * record, per-page CRC32 table). The page (IMAGE_STORE_BASE) is outside all
+ * DFU partitions and outside the region the service table may program, so
+ * only the bootloader writes it, after checking the image itself.
+ * 
+ * Layout: entries appended from offset 0, header (8 bytes) + data (padded
+ * to 8). Entry header: word0 = type | (len << 16), word1 = CRC32 of word0 +
+ * data. The latest entry of a type with a matching CRC wins. Erased flash
+ * (0xFF) ends the log.
+ * 
+ * Power-fail safety: an entry cut short by power loss fails its CRC and is
+ * skipped. An interrupted erase of a full page loses entries, which only
+ * costs a new check of the image at the next boot.
+ */
+
+#include "image_store.h"
+#include "config.h"
+#include "crc32.h"
+#include "flash_ops.h"
+#include <stdbool.h>
+#include <string.h>
+
+#define IMAGE_STORE_HDR_SIZE    8
+#define IMAGE_STORE_ERASED_WORD 0xFFFFFFFF
+
+/* Entry size in flash (header + data padded to double-word) */
+#define IMAGE_STORE_ENTRY_SIZE(len) (IMAGE_STORE_HDR_SIZE + (((len) + 7U) & ~7U))
+
+/**
+ * @brief Read 32-bit word from flash
+ */
+static inline uint32_t image_store_read_word(uint32_t addr)
+{
+    return *(const volatile uint32_t *)addr;
+}
+
+/**
+ * @brief Calculate entry CRC (header word0 + data)
+ */
+static uint32_t image_store_crc(uint32_t word0, const uint8_t *data, size_t len)
+{
+    uint8_t hdr[4] = {
+        (uint8_t)(word0 >> 0), (uint8_t)(word0 >> 8),
+        (uint8_t)(word0 >> 16), (uint8_t)(word0 >> 24)
+    };
+    
+    uint32_t crc = crc32_init();
+    crc = crc32_update(crc, hdr, sizeof(hdr));
+    crc = crc32_update(crc, data, len);
+    return crc32_finalize(crc);
+}
+
+/**
+ * @brief Check that a range of the page is erased
+ */
+static bool image_store_blank(uint32_t offset, uint32_t len)
+{
+    for (uint32_t addr = IMAGE_STORE_BASE + offset; addr < IMAGE_STORE_BASE + offset + len; addr += 4) {
+        if (image_store_read_word(addr) != IMAGE_STORE_ERASED_WORD) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/**
+ * @brief Walk the log
+ * 
+ * @param type Entry type to look for
+ * @param entry Address of the latest valid entry of the type, 0 if none
+ * @return Offset of the free space (IMAGE_STORE_SIZE if full or damaged)
+ */
+static uint32_t image_store_scan(uint16_t type, uint32_t *entry)
+{
+    uint32_t offset = 0;
+    
+    *entry = 0;
+    
+    while (offset + IMAGE_STORE_HDR_SIZE <= IMAGE_STORE_SIZE) {
+        uint32_t addr = IMAGE_STORE_BASE + offset;
+        uint32_t word0 = image_store_read_word(addr);
+        uint32_t word1 = image_store_read_word(addr + 4);
+        
+        /* End of log */
+        if (word0 == IMAGE_STORE_ERASED_WORD && word1 == IMAGE_STORE_ERASED_WORD) {
+            return offset;
+        }
+        
+        uint16_t len = (uint16_t)(word0 >> 16);
+        
+        /* Damaged header: no further appends to this page */
+        if (len == 0 || offset + IMAGE_STORE_ENTRY_SIZE(len) > IMAGE_STORE_SIZE) {
+            return IMAGE_STORE_SIZE;
+        }
+        
+        if ((uint16_t)word0 == type &&
+            image_store_crc(word0, (const uint8_t *)(addr + IMAGE_STORE_HDR_SIZE), len) == word1) {
+            *entry = addr;
+        }
+        
+        offset += IMAGE_STORE_ENTRY_SIZE(len);
+    }
+    
+    return IMAGE_STORE_SIZE;
+}
+
+/**
+ * @brief Read the latest entry of a type
+ */
+int image_store_read(uint16_t type, uint8_t *buf, size_t buf_len, size_t *out_len)
+{
+    uint32_t addr;
+    
+    (void)image_store_scan(type, &addr);
+    if (addr == 0) {
+        return ERR_NOT_FOUND;
+    }
+    
+    uint16_t len = (uint16_t)(image_store_read_word(addr) >> 16);
+    
+    if (out_len != NULL) {
+        *out_len = len;
+    }
+    
+    if (buf == NULL || buf_len < len) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    memcpy(buf, (const uint8_t *)(addr + IMAGE_STORE_HDR_SIZE), len);
+    return ERR_SUCCESS;
+}
+
+/**
+ * @brief Write entry
+ */
+int image_store_write(uint16_t type, const uint8_t *data, size_t len)
+{
+    if (data == NULL || len == 0 || IMAGE_STORE_ENTRY_SIZE(len) > IMAGE_STORE_SIZE) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    uint32_t addr;
+    uint32_t offset = image_store_scan(type, &addr);
+    
+    /* Unchanged entry: nothing to write */
+    if (addr != 0 && (image_store_read_word(addr) >> 16) == len &&
+        memcmp((const uint8_t *)(addr + IMAGE_STORE_HDR_SIZE), data, len) == 0) {
+        return ERR_SUCCESS;
+    }
+    
+    int result = flash_unlock();
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    /* Full page, or left over from an interrupted erase: start over */
+    if (offset + IMAGE_STORE_ENTRY_SIZE(len) > IMAGE_STORE_SIZE ||
+        !image_store_blank(offset, IMAGE_STORE_ENTRY_SIZE(len))) {
+        result = flash_erase_pages(IMAGE_STORE_BASE, IMAGE_STORE_SIZE);
+        offset = 0;
+    }
+    
+    uint32_t word0 = (uint32_t)type | ((uint32_t)len << 16);
+    uint32_t word1 = image_store_crc(word0, data, len);
+    addr = IMAGE_STORE_BASE + offset;
+    
+    /* Header first: CRC only matches once data is complete */
+    if (result == ERR_SUCCESS) {
+        result = flash_write_doubleword(addr, word0, word1);
+    }
+    if (result == ERR_SUCCESS) {
+        result = flash_write(addr + IMAGE_STORE_HDR_SIZE, data, len);
+    }
+    
+    flash_lock();
+    return result;
+}
+
+/**
+ * @brief Erase all entries
+ */
+int image_store_erase(void)
+{
+    /* Blank page: save the erase cycle (a partly erased page is erased again) */
+    if (image_store_blank(0, IMAGE_STORE_SIZE)) {
+        return ERR_SUCCESS;
+    }
+    
+    int result = flash_unlock();
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    result = flash_erase_pages(IMAGE_STORE_BASE, IMAGE_STORE_SIZE);
+    flash_lock();
+    return result;
+}
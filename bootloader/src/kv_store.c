@@ -0,0 +1,383 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file kv_store.c
+ * @brief Log-structured key/value store in reserved flash pages
+ * 
+ * Layout of each page in the KV region (KV_BASE, KV_PAGES pages):
+ * 
+ *   Offset 0: Page header (8 bytes)  - magic, sequence number
+ *   Offset 8: Records (appended)     - header (8 bytes) + data (padded to 8)
+ * 
+ * Record header: word0 = key | (len << 16), word1 = CRC32 of word0 + data.
+ * A record with len 0 deletes the key. Erased flash (0xFF) ends the log.
+ * 
+ * Power-fail safety:
+ * - A record is only valid once its CRC matches, so a record cut short by
+ *   power loss is ignored and the previous value stays in effect.
+ * - Garbage collection copies all live records into the next page and
+ *   writes that page's header last. Until then the old page stays active.
+ *   The page with the highest sequence number wins at initialization.
+ */
+
+#include "kv_store.h"
+#include "config.h"
+#include "crc32.h"
+#include "flash_ops.h"
+#include <string.h>
+
+#define KV_PAGE_MAGIC       0x4B565331  /* "KVS1" */
+#define KV_PAGE_HEADER_SIZE 8
+#define KV_RECORD_HDR_SIZE  8
+#define KV_ERASED_WORD      0xFFFFFFFF
+
+/* Record size in flash (header + data padded to double-word) */
+#define KV_RECORD_SIZE(len) (KV_RECORD_HDR_SIZE + (((len) + 7U) & ~7U))
+
+/**
+ * @brief Read 32-bit word from flash
+ */
+static inline uint32_t kv_read_word(uint32_t addr)
+{
+    return *(const volatile uint32_t *)addr;
+}
+
+/**
+ * @brief Calculate record CRC (header word0 + data)
+ */
+static uint32_t kv_record_crc(uint32_t word0, const uint8_t *data, size_t len)
+{
+    uint8_t hdr[4] = {
+        (uint8_t)(word0 >> 0), (uint8_t)(word0 >> 8),
+        (uint8_t)(word0 >> 16), (uint8_t)(word0 >> 24)
+    };
+    
+    uint32_t crc = crc32_init();
+    crc = crc32_update(crc, hdr, sizeof(hdr));
+    crc = crc32_update(crc, data, len);
+    return crc32_finalize(crc);
+}
+
+/**
+ * @brief Append record to active page (flash must be unlocked)
+ */
+static int kv_append(kv_store_t *kv, uint16_t key, const uint8_t *data, size_t len)
+{
+    uint32_t addr = kv->page_addr + kv->write_offset;
+    uint32_t word0 = (uint32_t)key | ((uint32_t)len << 16);
+    uint32_t word1 = kv_record_crc(word0, data, len);
+    uint8_t hdr[KV_RECORD_HDR_SIZE] = {
+        (uint8_t)(word0 >> 0), (uint8_t)(word0 >> 8),
+        (uint8_t)(word0 >> 16), (uint8_t)(word0 >> 24),
+        (uint8_t)(word1 >> 0), (uint8_t)(word1 >> 8),
+        (uint8_t)(word1 >> 16), (uint8_t)(word1 >> 24)
+    };
+    
+    /* Header first: CRC only matches once data is complete */
+    int result = flash_write(addr, hdr, sizeof(hdr));
+    if (result == ERR_SUCCESS && len > 0) {
+        result = flash_write(addr + KV_RECORD_HDR_SIZE, data, len);
+    }
+    
+    /* Space is consumed even on failure, never program the same location twice */
+    kv->write_offset += KV_RECORD_SIZE(len);
+    
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    kv->index[key] = (len > 0) ? (uint16_t)(addr - kv->page_addr) : 0;
+    return ERR_SUCCESS;
+}
+
+/**
+ * @brief Rebuild RAM index from the log in the active page
+ */
+static void kv_scan(kv_store_t *kv)
+{
+    uint32_t offset = KV_PAGE_HEADER_SIZE;
+    
+    memset(kv->index, 0, sizeof(kv->index));
+    
+    while (offset + KV_RECORD_HDR_SIZE <= FLASH_PAGE_SIZE) {
+        uint32_t addr = kv->page_addr + offset;
+        uint32_t word0 = kv_read_word(addr);
+        uint32_t word1 = kv_read_word(addr + 4);
+        
+        /* End of log */
+        if (word0 == KV_ERASED_WORD && word1 == KV_ERASED_WORD) {
+            break;
+        }
+        
+        uint16_t key = (uint16_t)(word0 & 0xFFFF);
+        uint16_t len = (uint16_t)(word0 >> 16);
+        
+        /* Corrupt header: stop here and force garbage collection on next write */
+        if (key >= KV_MAX_KEYS || len > KV_MAX_VALUE_LEN ||
+            offset + KV_RECORD_SIZE(len) > FLASH_PAGE_SIZE) {
+            offset = FLASH_PAGE_SIZE;
+            break;
+        }
+        
+        /* Incomplete record (power loss): skip, previous value stays */
+        const uint8_t *data = (const uint8_t *)(addr + KV_RECORD_HDR_SIZE);
+        if (kv_record_crc(word0, data, len) == word1) {
+            kv->index[key] = (len > 0) ? (uint16_t)offset : 0;
+        }
+        
+        offset += KV_RECORD_SIZE(len);
+    }
+    
+    kv->write_offset = (uint16_t)offset;
+}
+
+/**
+ * @brief Erase a page and make it the active page (flash must be unlocked)
+ */
+static int kv_format_page(kv_store_t *kv, uint32_t page_addr, uint32_t sequence)
+{
+    int result = flash_erase_pages(page_addr, FLASH_PAGE_SIZE);
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    result = flash_write_doubleword(page_addr, KV_PAGE_MAGIC, sequence);
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    kv->page_addr = page_addr;
+    kv->sequence = sequence;
+    kv->write_offset = KV_PAGE_HEADER_SIZE;
+    memset(kv->index, 0, sizeof(kv->index));
+    return ERR_SUCCESS;
+}
+
+/**
+ * @brief Copy live records into the next page (flash must be unlocked)
+ * 
+ * The new page header is written after all records are copied, so a power
+ * loss during collection leaves the old page active.
+ */
+static int kv_collect(kv_store_t *kv)
+{
+    uint32_t old_page = kv->page_addr;
+    uint32_t new_page = old_page + FLASH_PAGE_SIZE;
+    uint32_t offset = KV_PAGE_HEADER_SIZE;
+    
+    if (new_page >= KV_BASE + KV_SIZE) {
+        new_page = KV_BASE;
+    }
+    
+    int result = flash_erase_pages(new_page, FLASH_PAGE_SIZE);
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    for (uint16_t key = 0; key < KV_MAX_KEYS; key++) {
+        if (kv->index[key] == 0) {
+            continue;
+        }
+        
+        uint32_t src = old_page + kv->index[key];
+        uint16_t len = (uint16_t)(kv_read_word(src) >> 16);
+        uint32_t size = KV_RECORD_SIZE(len);
+        
+        /* Record already holds a valid CRC, copy as is */
+        result = flash_write(new_page + offset, (const uint8_t *)src, size);
+        if (result != ERR_SUCCESS) {
+            return result;
+        }
+        
+        kv->index[key] = (uint16_t)offset;
+        offset += size;
+    }
+    
+    /* Commit */
+    result = flash_write_doubleword(new_page, KV_PAGE_MAGIC, kv->sequence + 1);
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    kv->page_addr = new_page;
+    kv->sequence++;
+    kv->write_offset = (uint16_t)offset;
+    return ERR_SUCCESS;
+}
+
+/**
+ * @brief Write record, collecting garbage first if the page is full
+ */
+static int kv_write_record(kv_store_t *kv, uint16_t key, const uint8_t *data, size_t len)
+{
+    int result = flash_unlock();
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    if (kv->write_offset + KV_RECORD_SIZE(len) > FLASH_PAGE_SIZE) {
+        result = kv_collect(kv);
+        if (result != ERR_SUCCESS) {
+            flash_lock();
+            /* Index may point into the unfinished page, rebuild from flash */
+            kv_init(kv);
+            return result;
+        }
+    }
+    
+    if (kv->write_offset + KV_RECORD_SIZE(len) > FLASH_PAGE_SIZE) {
+        flash_lock();
+        return ERR_NO_SPACE;
+    }
+    
+    result = kv_append(kv, key, data, len);
+    flash_lock();
+    return result;
+}
+
+/**
+ * @brief Initialize key/value store
+ */
+int kv_init(kv_store_t *kv)
+{
+    if (kv == NULL) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    /* Find page with valid header and highest sequence number */
+    uint32_t best_page = 0;
+    uint32_t best_sequence = 0;
+    
+    for (uint32_t page = KV_BASE; page < KV_BASE + KV_SIZE; page += FLASH_PAGE_SIZE) {
+        uint32_t sequence = kv_read_word(page + 4);
+        
+        if (kv_read_word(page) != KV_PAGE_MAGIC || sequence == KV_ERASED_WORD) {
+            continue;
+        }
+        
+        if (best_page == 0 || sequence > best_sequence) {
+            best_page = page;
+            best_sequence = sequence;
+        }
+    }
+    
+    if (best_page != 0) {
+        kv->page_addr = best_page;
+        kv->sequence = best_sequence;
+        kv_scan(kv);
+        return ERR_SUCCESS;
+    }
+    
+    /* No valid page: format first page */
+    int result = flash_unlock();
+    if (result != ERR_SUCCESS) {
+        return result;
+    }
+    
+    result = kv_format_page(kv, KV_BASE, 1);
+    flash_lock();
+    return result;
+}
+
+/**
+ * @brief Check if the KV region holds a valid page
+ */
+bool kv_is_formatted(void)
+{
+    for (uint32_t page = KV_BASE; page < KV_BASE + KV_SIZE; page += FLASH_PAGE_SIZE) {
+        if (kv_read_word(page) == KV_PAGE_MAGIC && kv_read_word(page + 4) != KV_ERASED_WORD) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * @brief Read value
+ */
+int kv_get(const kv_store_t *kv, uint16_t key, uint8_t *buf, size_t buf_len, size_t *out_len)
+{
+    if (kv == NULL || key >= KV_MAX_KEYS) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    if (kv->index[key] == 0) {
+        return ERR_NOT_FOUND;
+    }
+    
+    uint32_t addr = kv->page_addr + kv->index[key];
+    uint16_t len = (uint16_t)(kv_read_word(addr) >> 16);
+    
+    if (out_len != NULL) {
+        *out_len = len;
+    }
+    
+    if (buf == NULL || buf_len < len) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    memcpy(buf, (const uint8_t *)(addr + KV_RECORD_HDR_SIZE), len);
+    return ERR_SUCCESS;
+}
+
+/**
+ * @brief Write value
+ */
+int kv_set(kv_store_t *kv, uint16_t key, const uint8_t *data, size_t len)
+{
+    if (kv == NULL || key >= KV_MAX_KEYS || data == NULL ||
+        len == 0 || len > KV_MAX_VALUE_LEN) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    /* Unchanged value: nothing to write */
+    if (kv->index[key] != 0) {
+        uint32_t addr = kv->page_addr + kv->index[key];
+        if ((kv_read_word(addr) >> 16) == len &&
+            memcmp((const uint8_t *)(addr + KV_RECORD_HDR_SIZE), data, len) == 0) {
+            return ERR_SUCCESS;
+        }
+    }
+    
+    return kv_write_record(kv, key, data, len);
+}
+
+/**
+ * @brief Delete value
+ */
+int kv_delete(kv_store_t *kv, uint16_t key)
+{
+    if (kv == NULL || key >= KV_MAX_KEYS) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    if (kv->index[key] == 0) {
+        return ERR_SUCCESS;
+    }
+    
+    return kv_write_record(kv, key, NULL, 0);
+}
@@ -0,0 +1,111 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file latency.c
+ * @brief Log-scale latency histograms for DFU request handling
+ * 
+ * Intervals are measured with the SysTick down-counter at the core clock.
+ * Intervals longer than LATENCY_FINE_MAX_MS (e.g. a DNLOAD block waiting
+ * for the background application check) fall back to the system time,
+ * at tick resolution.
+ */
+
+#include "hal.h"
+#include "latency.h"
+#include <string.h>
+
+#define LATENCY_FINE_MAX_MS     100
+
+static latency_hist_t hist[LATENCY_COUNT];
+
+/**
+ * @brief Start the SysTick cycle counter and clear the histograms
+ */
+void latency_init(void)
+{
+    memset(hist, 0, sizeof(hist));
+    
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+/**
+ * @brief Take a start time
+ */
+void latency_stamp(latency_stamp_t *stamp)
+{
+    stamp->cycles = SysTick->VAL;
+    stamp->time = chVTGetSystemTimeX();
+}
+
+/**
+ * @brief Record the time elapsed since a start time
+ */
+void latency_record(latency_id_t id, const latency_stamp_t *stamp)
+{
+    uint32_t cycles = SysTick->VAL;
+    sysinterval_t elapsed = chTimeDiffX(stamp->time, chVTGetSystemTimeX());
+    uint32_t us;
+    
+    if (elapsed < TIME_MS2I(LATENCY_FINE_MAX_MS)) {
+        /* Down-counter */
+        us = ((stamp->cycles - cycles) & SysTick_LOAD_RELOAD_Msk) / (STM32_SYSCLK / 1000000U);
+    } else {
+        us = (uint32_t)TIME_I2US(elapsed);
+    }
+    
+    /* Bucket: number of significant bits of us */
+    unsigned bucket = 0;
+    for (uint32_t v = us; v != 0 && bucket < LATENCY_BUCKETS - 1; v >>= 1) {
+        bucket++;
+    }
+    
+    syssts_t sts = chSysGetStatusAndLockX();
+    latency_hist_t *h = &hist[id];
+    if (h->count[bucket] != 0xFFFF) {
+        h->count[bucket]++;
+    }
+    if (us > h->max_us) {
+        h->max_us = us;
+    }
+    chSysRestoreStatusX(sts);
+}
+
+/**
+ * @brief Copy the histograms
+ */
+void latency_get(latency_stats_t *stats, bool clear)
+{
+    stats->version = LATENCY_VERSION;
+    stats->size = sizeof(latency_stats_t);
+    
+    syssts_t sts = chSysGetStatusAndLockX();
+    memcpy(stats->hist, hist, sizeof(hist));
+    if (clear) {
+        memset(hist, 0, sizeof(hist));
+    }
+    chSysRestoreStatusX(sts);
+}
@@ -35,32 +35,82 @@ SOFTWARE.
 #include "config.h"
 #include "bootloader.h"
 #include "usb_dfu.h"
+#include "boot_mailbox.h"
+#include "ram_stats.h"
 
+#if defined(_CHIBIOS_NIL_)
 /**
- * @brief Main bootloader entry point
+ * @brief Bootloader thread stack size (NIL build)
  * 
- * This function initializes ChibiOS, checks if bootloader should run,
- * and either enters DFU mode or jumps to application.
+ * Matches the RT main() stack (USE_PROCESS_STACKSIZE), Ed25519 field
+ * arithmetic needs about 2KB.
+ */
+#ifdef USE_IMAGE_SIGNATURE
+#define BOOTLOADER_THREAD_STACKSIZE 0xA00
+#else
+#define BOOTLOADER_THREAD_STACKSIZE 0x200
+#endif
+#endif
+
+/**
+ * @brief Background validation thread stack size
+ * 
+ * Ed25519 (first boot of a signed image without a verified-image record)
+ * needs about 2KB, the CRC32/SHA-256 checks a few hundred bytes.
+ */
+#ifdef USE_IMAGE_SIGNATURE
+#define VALIDATE_THREAD_STACKSIZE   0xA00
+#else
+#define VALIDATE_THREAD_STACKSIZE   0x400
+#endif
+
+/*
+ * Background validation: on a DFU request USB is started first and the
+ * application is checked meanwhile. The result is only needed when the DFU
+ * timeout expires.
+ */
+static THD_WORKING_AREA(waValidate, VALIDATE_THREAD_STACKSIZE);
+
+#if defined(_CHIBIOS_NIL_)
+/* NIL threads are started from the static table, the thread waits here */
+static SEMAPHORE_DECL(validate_sem, 0);
+#endif
+
+static THD_FUNCTION(ValidateThread, arg) {
+    (void)arg;
+#if defined(_CHIBIOS_NIL_)
+    while (true) {
+        chSemWait(&validate_sem);
+        bootloader_validate_background();
+    }
+#else
+    bootloader_validate_background();
+#endif
+}
+
+/**
+ * @brief Start background validation (below the bootloader thread priority)
+ */
+static void validate_start(void) {
+#if defined(_CHIBIOS_NIL_)
+    chSemSignal(&validate_sem);
+#else
+    chThdCreateStatic(waValidate, sizeof(waValidate), NORMALPRIO - 1, ValidateThread, NULL);
+#endif
+}
+
+/**
+ * @brief Bootloader entry logic (runs after kernel initialization)
  * 
  * Bootloader entry conditions:
- * 1. Magic value in RAM (set by application for firmware update)
+ * 1. Magic value in RAM or boot mailbox request (set by application)
  * 2. Invalid application firmware (CRC check fails)
  * 3. User button pressed during reset
  * 4. Watchdog reset detected (commented out until watchdog implemented)
  */
-int main(void) {
+static void bootloader_main(void) {
     int result;
 
-    /*
-     * System initializations.
-     * - HAL initialization, this also initializes the configured device drivers
-     *   and performs the board-specific initializations.
-     * - Kernel initialization, the main() function becomes a thread and the
-     *   RTOS is active.
-     */
-    halInit();
-    chSysInit();
-
     /* Initialize bootloader */
     result = bootloader_init();
     if (result != ERR_SUCCESS) {
@@ -73,12 +123,27 @@ int main(void) {
 
     /* Check bootloader entry conditions */
     if (bootloader_should_enter()) {
-        /* Initialize USB DFU */
+        /* Initialize USB DFU first, check the application meanwhile */
         usb_dfu_init();
+        if (bootloader_validation_pending()) {
+            validate_start();
+        }
 
         /* Run bootloader - wait for firmware update via USB DFU */
         bootloader_run();
 
+        /* Data partition update with the image untouched: carry the
+         * application's own image check over the reset */
+        if (mailbox_action() == MAILBOX_ACTION_DATA_UPDATE && !usb_dfu_app_modified()) {
+            mailbox_request(MAILBOX_ACTION_SKIP_CHECK, mailbox_arg());
+        }
+
+        /* Installed image downloaded again: it was compared with flash, so
+         * skip the image check on the next boot */
+        if (usb_dfu_up_to_date()) {
+            mailbox_request(MAILBOX_ACTION_SKIP_CHECK, ((const app_header_t *)APP_BASE)->crc32);
+        }
+
         /* After successful firmware update, reset to boot new firmware */
         NVIC_SystemReset();
     }
@@ -99,6 +164,55 @@ int main(void) {
     while (true) {
         chThdSleepMilliseconds(1000);
     }
+}
+
+#if defined(_CHIBIOS_NIL_)
+/*
+ * NIL build: the bootloader and the background validation run as threads
+ * of the static thread table, main() becomes the idle thread.
+ */
+static THD_WORKING_AREA(waBootloader, BOOTLOADER_THREAD_STACKSIZE);
+
+static THD_FUNCTION(BootloaderThread, arg) {
+    (void)arg;
+    bootloader_main();
+}
+
+THD_TABLE_BEGIN
+  THD_TABLE_THREAD(0, "bootloader", waBootloader, BootloaderThread, NULL)
+  THD_TABLE_THREAD(1, "validate", waValidate, ValidateThread, NULL)
+THD_TABLE_END
+#endif
+
+/**
+ * @brief Main bootloader entry point
+ * 
+ * This function initializes ChibiOS, checks if bootloader should run,
+ * and either enters DFU mode or jumps to application.
+ */
+int main(void) {
+    /*
+     * System initializations.
+     * - HAL initialization, this also initializes the configured device drivers
+     *   and performs the board-specific initializations.
+     * - Kernel initialization, the main() function becomes a thread and the
+     *   RTOS is active (RT), or the idle thread (NIL).
+     * Thread working areas are filled for the stack high-water marks first.
+     */
+#if defined(_CHIBIOS_NIL_)
+    ram_stats_add_stack(RAM_STACK_BOOTLOADER, waBootloader, sizeof(waBootloader));
+#endif
+    ram_stats_add_stack(RAM_STACK_VALIDATE, waValidate, sizeof(waValidate));
+    halInit();
+    chSysInit();
+
+#if defined(_CHIBIOS_NIL_)
+    /* Idle thread loop, must never sleep or wait */
+    while (true) {
+    }
+#else
+    bootloader_main();
+#endif
 
     return 0;
 }
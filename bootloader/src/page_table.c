@@ -0,0 +1,139 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file page_table.c
+ * @brief Per-page CRC32 table of the application image (partial boot check)
+ */
+
+#include "page_table.h"
+#include "crc32.h"
+
+/**
+ * @brief Number of flash pages spanned by an image
+ */
+uint32_t page_table_pages(uint32_t size)
+{
+    return (APP_VECTOR_TABLE_OFFSET + size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+}
+
+/**
+ * @brief Image bytes in flash page (page 0 starts at the vector table)
+ */
+static const uint8_t *page_table_range(uint32_t size, uint32_t page, uint32_t *len)
+{
+    uint32_t image_start = APP_BASE + APP_VECTOR_TABLE_OFFSET;
+    uint32_t image_end = image_start + size;
+    uint32_t start = APP_BASE + page * FLASH_PAGE_SIZE;
+    uint32_t end = start + FLASH_PAGE_SIZE;
+    
+    if (start < image_start) {
+        start = image_start;
+    }
+    if (end > image_end) {
+        end = image_end;
+    }
+    
+    *len = end - start;
+    return (const uint8_t *)start;
+}
+
+/**
+ * @brief Build the table of the image in flash
+ */
+size_t page_table_build(page_table_t *table, uint32_t size, uint32_t crc32)
+{
+    uint32_t pages = page_table_pages(size);
+    
+    for (uint32_t i = 0; i < pages; i++) {
+        uint32_t len;
+        const uint8_t *data = page_table_range(size, i, &len);
+        table->page_crc[i] = crc32_calculate(data, len);
+    }
+    
+    table->size = size;
+    table->crc32 = crc32;
+    
+    return offsetof(page_table_t, page_crc) + pages * sizeof(uint32_t);
+}
+
+/**
+ * @brief Check that a stored table belongs to an image
+ */
+bool page_table_valid(const page_table_t *table, size_t len, uint32_t size, uint32_t crc32)
+{
+    uint32_t pages = page_table_pages(size);
+    
+    if (pages > PAGE_TABLE_MAX_PAGES ||
+        len != offsetof(page_table_t, page_crc) + pages * sizeof(uint32_t) ||
+        table->size != size || table->crc32 != crc32) {
+        return false;
+    }
+    
+    uint32_t full_op = crc32_combine_gen(FLASH_PAGE_SIZE);
+    uint32_t crc = table->page_crc[0];
+    for (uint32_t i = 1; i < pages; i++) {
+        uint32_t page_len;
+        (void)page_table_range(size, i, &page_len);
+        uint32_t op = (page_len == FLASH_PAGE_SIZE) ? full_op : crc32_combine_gen(page_len);
+        crc = crc32_combine_op(crc, table->page_crc[i], op);
+    }
+    
+    return crc == crc32;
+}
+
+/**
+ * @brief Check the vector table page and further pages in rotation
+ */
+bool page_table_check(const page_table_t *table, uint8_t *cursor, uint32_t count)
+{
+    uint32_t pages = page_table_pages(table->size);
+    uint8_t next = *cursor;
+    
+    if (next == 0 || next >= pages) {
+        next = 1;
+    }
+    
+    if (count > pages - 1) {
+        count = pages - 1;
+    }
+    
+    bool match = true;
+    
+    /* Page 0 (vector table) is always checked */
+    for (uint32_t n = 0; n <= count && match; n++) {
+        uint32_t page = 0;
+        if (n > 0) {
+            page = next;
+            next = ((uint32_t)next + 1U < pages) ? next + 1 : 1;
+        }
+        
+        uint32_t len;
+        const uint8_t *data = page_table_range(table->size, page, &len);
+        match = crc32_calculate(data, len) == table->page_crc[page];
+    }
+    
+    *cursor = next;
+    return match;
+}
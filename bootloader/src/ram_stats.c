@@ -0,0 +1,120 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file ram_stats.c
+ * @brief Stack high-water marks and RAM usage report
+ * 
+ * Stack usage is found by scanning from the stack base (lowest address,
+ * stacks grow down) for the first word that no longer holds the fill
+ * pattern. Sizes of the static sections come from the linker script
+ * symbols (ChibiOS rules.ld).
+ */
+
+#include "ch.h"
+#include "ram_stats.h"
+#include "config.h"
+#include "usb_dfu.h"
+
+/* Linker script symbols */
+extern uint32_t __main_stack_base__[], __main_stack_end__[];
+extern uint32_t __process_stack_base__[], __process_stack_end__[];
+extern uint32_t __data_base__[], __data_end__[];
+extern uint32_t __bss_base__[], __bss_end__[];
+extern uint32_t __heap_base__[], __heap_end__[];
+
+/**
+ * @brief Registered stack
+ */
+typedef struct {
+    uint32_t *base;
+    size_t size;
+} ram_stack_area_t;
+
+static ram_stack_area_t stacks[RAM_STACK_COUNT];
+
+/**
+ * @brief Register a thread working area and fill it with the stack pattern
+ */
+void ram_stats_add_stack(ram_stack_t id, void *base, size_t size)
+{
+    uint32_t *p = (uint32_t *)base;
+    
+    for (size_t i = 0; i < size / sizeof(uint32_t); i++) {
+        p[i] = RAM_STATS_FILL_PATTERN;
+    }
+    
+    stacks[id].base = p;
+    stacks[id].size = size;
+}
+
+/**
+ * @brief Size and high-water mark of a stack
+ */
+static ram_stack_usage_t stack_usage(const uint32_t *base, size_t size)
+{
+    ram_stack_usage_t usage;
+    size_t words = size / sizeof(uint32_t);
+    size_t unused = 0;
+    
+    while (unused < words && base[unused] == RAM_STATS_FILL_PATTERN) {
+        unused++;
+    }
+    
+    usage.size = (uint16_t)size;
+    usage.used = (uint16_t)((words - unused) * sizeof(uint32_t));
+    return usage;
+}
+
+/**
+ * @brief Collect the RAM usage report
+ */
+void ram_stats_get(ram_stats_t *stats)
+{
+    stats->version = RAM_STATS_VERSION;
+    stats->size = sizeof(ram_stats_t);
+    stats->ram_size = RAM_SIZE - BOOT_MAILBOX_RESERVED;
+    stats->data_size = (uint32_t)((uint8_t *)__data_end__ - (uint8_t *)__data_base__);
+    stats->bss_size = (uint32_t)((uint8_t *)__bss_end__ - (uint8_t *)__bss_base__);
+    stats->free_size = (uint32_t)((uint8_t *)__heap_end__ - (uint8_t *)__heap_base__);
+    
+    stacks[RAM_STACK_EXCEPTIONS].base = __main_stack_base__;
+    stacks[RAM_STACK_EXCEPTIONS].size = (size_t)((uint8_t *)__main_stack_end__ - (uint8_t *)__main_stack_base__);
+    stacks[RAM_STACK_MAIN].base = __process_stack_base__;
+    stacks[RAM_STACK_MAIN].size = (size_t)((uint8_t *)__process_stack_end__ - (uint8_t *)__process_stack_base__);
+    
+#if !defined(_CHIBIOS_NIL_)
+    /* Idle thread structure is at the top of its working area */
+    thread_t *idle = chSysGetIdleThreadX();
+    stacks[RAM_STACK_IDLE].base = (uint32_t *)chThdGetWorkingAreaX(idle);
+    stacks[RAM_STACK_IDLE].size = (size_t)((uint8_t *)idle - (uint8_t *)stacks[RAM_STACK_IDLE].base);
+#endif
+    
+    for (int i = 0; i < RAM_STACK_COUNT; i++) {
+        stats->stack[i] = stack_usage(stacks[i].base, stacks[i].size);
+    }
+    
+    stats->xfer_size = DFU_XFER_SIZE;
+    stats->xfer_peak = usb_dfu_xfer_peak();
+}
@@ -0,0 +1,211 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file sha256.c
+ * @brief Compact SHA-256 (FIPS 180-4) for Cortex-M0+
+ * 
+ * - Message schedule kept in a 16-word ring instead of 64 words (64 bytes
+ *   of stack instead of 256).
+ * - Rounds are unrolled by 8 with the working variables renamed per round,
+ *   so no register shuffling between rounds.
+ * - Constants in flash, no RAM state besides the caller's context.
+ */
+
+#include "sha256.h"
+#include <string.h>
+
+static const uint32_t sha256_k[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5,
+    0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+    0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+    0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC,
+    0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7,
+    0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+    0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+    0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3,
+    0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5,
+    0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+    0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+#define ROR(x, n)   (((x) >> (n)) | ((x) << (32 - (n))))
+#define CH(x, y, z) ((z) ^ ((x) & ((y) ^ (z))))
+#define MAJ(x, y, z) (((x) & (y)) | ((z) & ((x) | (y))))
+#define S0(x)       (ROR(x, 2) ^ ROR(x, 13) ^ ROR(x, 22))
+#define S1(x)       (ROR(x, 6) ^ ROR(x, 11) ^ ROR(x, 25))
+#define G0(x)       (ROR(x, 7) ^ ROR(x, 18) ^ ((x) >> 3))
+#define G1(x)       (ROR(x, 17) ^ ROR(x, 19) ^ ((x) >> 10))
+
+/* Schedule word i (i >= 16) in the 16-word ring */
+#define W(i)        (w[(i) & 15] += G1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + G0(w[((i) - 15) & 15]))
+
+/* One round, working variables passed in rotated order */
+#define ROUND(a, b, c, d, e, f, g, h, i, wi) do {               \
+        uint32_t t1 = (h) + S1(e) + CH(e, f, g) + sha256_k[i] + (wi); \
+        (d) += t1;                                              \
+        (h) = t1 + S0(a) + MAJ(a, b, c);                        \
+    } while (0)
+
+/**
+ * @brief Process one 64-byte block
+ */
+static void sha256_transform(uint32_t state[8], const uint8_t *block)
+{
+    uint32_t w[16];
+    uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+    uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+    
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)block[4 * i] << 24) | ((uint32_t)block[4 * i + 1] << 16) |
+               ((uint32_t)block[4 * i + 2] << 8) | (uint32_t)block[4 * i + 3];
+    }
+    
+    for (int i = 0; i < 16; i += 8) {
+        ROUND(a, b, c, d, e, f, g, h, i + 0, w[i + 0]);
+        ROUND(h, a, b, c, d, e, f, g, i + 1, w[i + 1]);
+        ROUND(g, h, a, b, c, d, e, f, i + 2, w[i + 2]);
+        ROUND(f, g, h, a, b, c, d, e, i + 3, w[i + 3]);
+        ROUND(e, f, g, h, a, b, c, d, i + 4, w[i + 4]);
+        ROUND(d, e, f, g, h, a, b, c, i + 5, w[i + 5]);
+        ROUND(c, d, e, f, g, h, a, b, i + 6, w[i + 6]);
+        ROUND(b, c, d, e, f, g, h, a, i + 7, w[i + 7]);
+    }
+    
+    for (int i = 16; i < 64; i += 8) {
+        ROUND(a, b, c, d, e, f, g, h, i + 0, W(i + 0));
+        ROUND(h, a, b, c, d, e, f, g, i + 1, W(i + 1));
+        ROUND(g, h, a, b, c, d, e, f, i + 2, W(i + 2));
+        ROUND(f, g, h, a, b, c, d, e, i + 3, W(i + 3));
+        ROUND(e, f, g, h, a, b, c, d, i + 4, W(i + 4));
+        ROUND(d, e, f, g, h, a, b, c, i + 5, W(i + 5));
+        ROUND(c, d, e, f, g, h, a, b, i + 6, W(i + 6));
+        ROUND(b, c, d, e, f, g, h, a, i + 7, W(i + 7));
+    }
+    
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+/**
+ * @brief Initialize SHA-256 calculation
+ */
+void sha256_init(sha256_ctx_t *ctx)
+{
+    ctx->state[0] = 0x6A09E667;
+    ctx->state[1] = 0xBB67AE85;
+    ctx->state[2] = 0x3C6EF372;
+    ctx->state[3] = 0xA54FF53A;
+    ctx->state[4] = 0x510E527F;
+    ctx->state[5] = 0x9B05688C;
+    ctx->state[6] = 0x1F83D9AB;
+    ctx->state[7] = 0x5BE0CD19;
+    ctx->count = 0;
+}
+
+/**
+ * @brief Update SHA-256 with new data
+ */
+void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    size_t fill = ctx->count % SHA256_BLOCK_SIZE;
+    
+    ctx->count += len;
+    
+    /* Complete partial block */
+    if (fill > 0) {
+        size_t n = SHA256_BLOCK_SIZE - fill;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(&ctx->buffer[fill], data, n);
+        data += n;
+        len -= n;
+        if (fill + n < SHA256_BLOCK_SIZE) {
+            return;
+        }
+        sha256_transform(ctx->state, ctx->buffer);
+    }
+    
+    /* Full blocks directly from source (flash or RAM) */
+    while (len >= SHA256_BLOCK_SIZE) {
+        sha256_transform(ctx->state, data);
+        data += SHA256_BLOCK_SIZE;
+        len -= SHA256_BLOCK_SIZE;
+    }
+    
+    if (len > 0) {
+        memcpy(ctx->buffer, data, len);
+    }
+}
+
+/**
+ * @brief Finalize SHA-256 calculation
+ */
+void sha256_final(sha256_ctx_t *ctx, uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    size_t fill = ctx->count % SHA256_BLOCK_SIZE;
+    uint32_t bits_hi = ctx->count >> 29;
+    uint32_t bits_lo = ctx->count << 3;
+    
+    /* Padding: 0x80, zeros, 64-bit big-endian bit length */
+    ctx->buffer[fill++] = 0x80;
+    if (fill > SHA256_BLOCK_SIZE - 8) {
+        memset(&ctx->buffer[fill], 0, SHA256_BLOCK_SIZE - fill);
+        sha256_transform(ctx->state, ctx->buffer);
+        fill = 0;
+    }
+    memset(&ctx->buffer[fill], 0, SHA256_BLOCK_SIZE - 8 - fill);
+    
+    for (int i = 0; i < 4; i++) {
+        ctx->buffer[56 + i] = (uint8_t)(bits_hi >> (24 - 8 * i));
+        ctx->buffer[60 + i] = (uint8_t)(bits_lo >> (24 - 8 * i));
+    }
+    sha256_transform(ctx->state, ctx->buffer);
+    
+    for (int i = 0; i < 8; i++) {
+        digest[4 * i + 0] = (uint8_t)(ctx->state[i] >> 24);
+        digest[4 * i + 1] = (uint8_t)(ctx->state[i] >> 16);
+        digest[4 * i + 2] = (uint8_t)(ctx->state[i] >> 8);
+        digest[4 * i + 3] = (uint8_t)(ctx->state[i]);
+    }
+}
+
+/**
+ * @brief Calculate SHA-256 digest (convenience function)
+ */
+void sha256_calculate(const uint8_t *data, size_t len, uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    sha256_ctx_t ctx;
+    
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, len);
+    sha256_final(&ctx, digest);
+}
@@ -36,6 +36,10 @@ SOFTWARE.
 #include "config.h"
 #include "flash_ops.h"
 #include "bootloader.h"
+#include "kv_store.h"
+#include "sha256.h"
+#include "ram_stats.h"
+#include "latency.h"
 #include "stm32c071xx.h"
 #include <string.h>
 
@@ -56,6 +60,55 @@ SOFTWARE.
                                      USB_RTYPE_TYPE_CLASS | \
                                      USB_RTYPE_RECIPIENT_INTERFACE)
 
+/*===========================================================================*/
+/* DFU Partitions                                                            */
+/*===========================================================================*/
+
+/**
+ * @brief Partition erase policy
+ */
+typedef enum {
+    PART_ERASE_ALL,         /* Erase whole partition once, on first erase command or data block */
+    PART_ERASE_ON_TOUCH     /* Erase only the pages addressed by erase commands or data blocks */
+} part_erase_t;
+
+/**
+ * @brief Partition validation policy
+ */
+typedef enum {
+    PART_VALIDATE_AT_BOOT,  /* Application header and CRC32 checked at next boot */
+    PART_VALIDATE_KV,       /* Key/value page header checked at manifestation */
+    PART_VALIDATE_NONE      /* Raw data, no validation */
+} part_validate_t;
+
+/**
+ * @brief Flash partition mapped to a DFU alternate setting
+ */
+typedef struct {
+    uint32_t base;
+    uint32_t size;
+    part_erase_t erase;
+    part_validate_t validate;
+} dfu_partition_t;
+
+/**
+ * @brief Partition table (index = bAlternateSetting)
+ * 
+ * Must match the interface descriptors and DFUSe strings below.
+ */
+static const dfu_partition_t dfu_partitions[] = {
+    {APP_BASE, APP_MAX_SIZE, PART_ERASE_ALL,      PART_VALIDATE_AT_BOOT},  /* 0: Application */
+    {KV_BASE,  KV_SIZE,      PART_ERASE_ALL,      PART_VALIDATE_KV},       /* 1: Data        */
+    {CAL_BASE, CAL_SIZE,     PART_ERASE_ON_TOUCH, PART_VALIDATE_NONE}      /* 2: Calibration */
+};
+
+#define DFU_NUM_PARTITIONS  (sizeof(dfu_partitions) / sizeof(dfu_partitions[0]))
+
+/* Erase-on-touch partitions track erased pages in a bitmap */
+#define DFU_ERASE_MAP_WORDS ((CAL_PAGES + 31) / 32)
+
+_Static_assert(DFU_XFER_SIZE % FLASH_ROW_SIZE == 0, "DFU block size must be a multiple of the flash row");
+
 /*===========================================================================*/
 /* DFU Context                                                               */
 /*===========================================================================*/
@@ -68,11 +121,149 @@ static struct {
     uint16_t block_num;
     uint8_t buffer[DFU_XFER_SIZE] __attribute__((aligned(4)));  /* 4-byte aligned for flash writes */
     uint16_t buffer_len;
+    uint16_t xfer_peak;             /* Largest download block received */
     bool download_complete;
     bool erase_done;                /* Track if explicit erase was performed */
+    uint32_t erased_pages[DFU_ERASE_MAP_WORDS]; /* Pages erased this session (PART_ERASE_ON_TOUCH) */
+    uint8_t alt_setting;            /* Selected alternate setting (partition) */
+    bool manifest_pending;          /* Download finished, manifestation not yet run */
+    bool app_modified;              /* Application partition erased or written */
+    bool erase_pending;             /* Application erase deferred (USE_DFU_SKIP_IDENTICAL) */
+    bool up_to_date;                /* Image matches the installed one, not written */
+    bool getstatus_seen;            /* First DFU_GETSTATUS received (set in ISR) */
+    bool ready_done;                /* ready_ticks complete */
+    systime_t getstatus_time;       /* System time of first DFU_GETSTATUS */
+    systime_t ready_last;           /* Last update of ready_ticks */
+    sysinterval_t ready_ticks;      /* Kernel start to first DFU_GETSTATUS */
+    latency_stamp_t data_stamp;     /* DNLOAD data stage complete (set in ISR) */
+    bool data_stamped;              /* data_stamp not recorded yet */
+    sha256_ctx_t sha;               /* Image digest, streamed during download */
+    uint32_t hash_addr;             /* Next flash address to hash */
+    bool hash_valid;                /* Writes so far were sequential */
     uint32_t poll_timeout;  /* Time in milliseconds for flash operation */
 } dfu_ctx;
 
+/**
+ * @brief Get selected partition
+ */
+static inline const dfu_partition_t *dfu_partition(void) {
+    return &dfu_partitions[dfu_ctx.alt_setting];
+}
+
+/**
+ * @brief Check if range is inside the selected partition
+ */
+static bool dfu_partition_contains(uint32_t addr, uint32_t len) {
+    const dfu_partition_t *part = dfu_partition();
+    
+    if (addr < part->base || addr >= part->base + part->size) {
+        return false;
+    }
+    
+    return len <= (part->base + part->size) - addr;
+}
+
+/**
+ * @brief Check if a DFUSe erase command is deferred to the first data block
+ * 
+ * With USE_DFU_SKIP_IDENTICAL the application partition is erased only once
+ * the first block shows that the image differs from the installed one.
+ */
+static bool dfu_erase_deferred(void) {
+#ifdef USE_DFU_SKIP_IDENTICAL
+    return dfu_partition()->validate == PART_VALIDATE_AT_BOOT;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Reset download session for the selected partition
+ */
+static void dfu_session_reset(void) {
+    dfu_ctx.current_address = dfu_partition()->base;
+    dfu_ctx.target_address = dfu_partition()->base;
+    dfu_ctx.erase_done = false;
+    dfu_ctx.erase_pending = false;
+    dfu_ctx.up_to_date = false;
+    memset(dfu_ctx.erased_pages, 0, sizeof(dfu_ctx.erased_pages));
+    
+    /* Image digest starts at the vector table, like the CRC32 */
+    sha256_init(&dfu_ctx.sha);
+    dfu_ctx.hash_addr = APP_BASE + APP_VECTOR_TABLE_OFFSET;
+    dfu_ctx.hash_valid = true;
+}
+
+/**
+ * @brief Feed newly written application flash to the image digest
+ * 
+ * Hashes from flash (what was actually programmed). Sequential downloads
+ * are hashed block by block; any gap or rewrite invalidates the stream and
+ * the image is hashed in one go at manifestation instead.
+ */
+static void dfu_hash_update(uint32_t addr, uint32_t len) {
+    uint32_t end = addr + len;
+    
+    if (dfu_ctx.alt_setting != 0 || !dfu_ctx.hash_valid) {
+        return;
+    }
+    
+    /* Header block (before vector table) is not part of the digest */
+    if (end <= APP_BASE + APP_VECTOR_TABLE_OFFSET) {
+        return;
+    }
+    
+    if (addr > dfu_ctx.hash_addr || end <= dfu_ctx.hash_addr) {
+        dfu_ctx.hash_valid = false;  /* Gap or rewrite */
+        return;
+    }
+    
+    sha256_update(&dfu_ctx.sha, (const uint8_t *)dfu_ctx.hash_addr, end - dfu_ctx.hash_addr);
+    dfu_ctx.hash_addr = end;
+}
+
+/**
+ * @brief Manifestation: finish image digest and store verified-image record
+ * 
+ * @return true if download may complete, false on digest mismatch
+ */
+static bool dfu_manifest(void) {
+    const app_header_t *header = (const app_header_t *)APP_BASE;
+    uint32_t start = APP_BASE + APP_VECTOR_TABLE_OFFSET;
+    
+    /* Nothing written, the installed image keeps its record */
+    if (dfu_ctx.alt_setting == 0 && dfu_ctx.up_to_date) {
+        return true;
+    }
+    
+    if (dfu_ctx.alt_setting != 0 || header->magic != APP_HEADER_MAGIC ||
+        header->size == 0 || header->size > APP_MAX_SIZE - APP_VECTOR_TABLE_OFFSET) {
+        return true;  /* Nothing to record, validated at boot */
+    }
+    
+    uint32_t end = start + header->size;
+    
+    /* Non-sequential download: hash the whole image now */
+    if (!dfu_ctx.hash_valid || dfu_ctx.hash_addr > end) {
+        sha256_init(&dfu_ctx.sha);
+        dfu_ctx.hash_addr = start;
+    }
+    
+    if (dfu_ctx.hash_addr < end) {
+        sha256_update(&dfu_ctx.sha, (const uint8_t *)dfu_ctx.hash_addr, end - dfu_ctx.hash_addr);
+    }
+    
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256_final(&dfu_ctx.sha, digest);
+    dfu_ctx.hash_valid = false;
+    
+    /* Only a digest or signature mismatch fails the download, record errors
+     * are retried at boot */
+    int ret = bootloader_record_image(digest);
+    
+    return ret != ERR_INVALID_CRC && ret != ERR_INVALID_SIGNATURE;
+}
+
 /*===========================================================================*/
 /* USB Descriptors                                                           */
 /*===========================================================================*/
@@ -143,17 +334,20 @@ static void get_usb_vid_pid(uint16_t *vid, uint16_t *pid) {
 
 /**
  * @brief Configuration Descriptor with DFU Interface
+ * 
+ * One interface with an alternate setting per flash partition. DFUSe hosts
+ * select the partition by alternate setting (dfu-util -a <n>).
  */
-static const uint8_t vcom_configuration_descriptor_data[27] = {
+static const uint8_t vcom_configuration_descriptor_data[45] = {
     /* Configuration Descriptor (9 bytes) */
-    USB_DESC_CONFIGURATION(27,              /* wTotalLength (9+9+9)        */
+    USB_DESC_CONFIGURATION(45,              /* wTotalLength (9+3*9+9)      */
                            1,                /* bNumInterfaces              */
                            1,                /* bConfigurationValue         */
                            0,                /* iConfiguration              */
                            0x80,             /* bmAttributes (bus powered)  */
                            50),              /* bMaxPower (100mA)           */
     
-    /* Interface Descriptor (9 bytes) */
+    /* Interface Descriptor, alternate setting 0: Application (9 bytes) */
     USB_DESC_INTERFACE(0,                   /* bInterfaceNumber            */
                        0,                   /* bAlternateSetting           */
                        0,                   /* bNumEndpoints (DFU uses EP0)*/
@@ -162,6 +356,24 @@ static const uint8_t vcom_configuration_descriptor_data[27] = {
                        0x02,                /* bInterfaceProtocol (DFU)    */
                        4),                  /* iInterface                  */
     
+    /* Interface Descriptor, alternate setting 1: Data (9 bytes) */
+    USB_DESC_INTERFACE(0,                   /* bInterfaceNumber            */
+                       1,                   /* bAlternateSetting           */
+                       0,                   /* bNumEndpoints (DFU uses EP0)*/
+                       0xFE,                /* bInterfaceClass (App Spec)  */
+                       0x01,                /* bInterfaceSubClass (DFU)    */
+                       0x02,                /* bInterfaceProtocol (DFU)    */
+                       5),                  /* iInterface                  */
+    
+    /* Interface Descriptor, alternate setting 2: Calibration (9 bytes) */
+    USB_DESC_INTERFACE(0,                   /* bInterfaceNumber            */
+                       2,                   /* bAlternateSetting           */
+                       0,                   /* bNumEndpoints (DFU uses EP0)*/
+                       0xFE,                /* bInterfaceClass (App Spec)  */
+                       0x01,                /* bInterfaceSubClass (DFU)    */
+                       0x02,                /* bInterfaceProtocol (DFU)    */
+                       6),                  /* iInterface                  */
+    
     /* DFU Functional Descriptor (9 bytes) */
     USB_DESC_BYTE(DFU_DESC_FUNCTIONAL_SIZE),        /* bLength             */
     USB_DESC_BYTE(0x21),                            /* bDescriptorType (DFU)*/
@@ -211,18 +423,74 @@ static const uint8_t vcom_string3[] = {
     '8', 0, '9', 0, 'A', 0, 'B', 0
 };
 
-/* DFUSe interface string descriptor */
-/* Format: @Internal Flash  /0x08004000/112*001Kg */
+/*
+ * DFUSe interface string descriptors (one per alternate setting), generated
+ * from the memory map: "@<Name> /0x<base>/<pages>*<page KB>Kg", e.g.
+ * "@Application /0x08004000/052*002Kg" on STM32C071xB.
+ */
+#define DFUSE_CHAR(c)           (uint8_t)(c), 0
+#define DFUSE_HEX(v, n)         DFUSE_CHAR((((v) >> (4 * (n))) & 0xF) < 10 ? \
+                                           '0' + (((v) >> (4 * (n))) & 0xF) : \
+                                           'A' - 10 + (((v) >> (4 * (n))) & 0xF))
+#define DFUSE_DEC3(v)           DFUSE_CHAR('0' + ((v) / 100) % 10), \
+                                DFUSE_CHAR('0' + ((v) / 10) % 10),  \
+                                DFUSE_CHAR('0' + (v) % 10)
+
+/* " /0xXXXXXXXX/NNN*SSSKg" */
+#define DFUSE_LAYOUT_CHARS      22
+#define DFUSE_LAYOUT(base, size)                                                \
+    DFUSE_CHAR(' '), DFUSE_CHAR('/'), DFUSE_CHAR('0'), DFUSE_CHAR('x'),         \
+    DFUSE_HEX(base, 7), DFUSE_HEX(base, 6), DFUSE_HEX(base, 5), DFUSE_HEX(base, 4), \
+    DFUSE_HEX(base, 3), DFUSE_HEX(base, 2), DFUSE_HEX(base, 1), DFUSE_HEX(base, 0), \
+    DFUSE_CHAR('/'), DFUSE_DEC3((size) / FLASH_PAGE_SIZE), DFUSE_CHAR('*'),     \
+    DFUSE_DEC3(FLASH_PAGE_SIZE / 1024), DFUSE_CHAR('K'), DFUSE_CHAR('g')
+
+#define DFUSE_STRING_LENGTH(name_chars) (2 + 2 * ((name_chars) + DFUSE_LAYOUT_CHARS))
+
+_Static_assert(FLASH_PAGE_SIZE % 1024 == 0 && FLASH_PAGE_SIZE / 1024 < 1000,
+               "DFUSe sector size must be whole KB (3 digits)");
+_Static_assert(APP_MAX_SIZE / FLASH_PAGE_SIZE < 1000, "DFUSe sector count must fit 3 digits");
+_Static_assert(APP_MAX_SIZE % FLASH_PAGE_SIZE == 0 && KV_SIZE % FLASH_PAGE_SIZE == 0 &&
+               CAL_SIZE % FLASH_PAGE_SIZE == 0, "Partitions must be whole pages");
+
 static const uint8_t vcom_string4[] = {
-    USB_DESC_BYTE(78),                      /* bLength (2 + 38*2)           */
+    USB_DESC_BYTE(DFUSE_STRING_LENGTH(12)), /* bLength                      */
     USB_DESC_BYTE(USB_DESCRIPTOR_STRING),   /* bDescriptorType              */
-    '@', 0, 'I', 0, 'n', 0, 't', 0, 'e', 0, 'r', 0, 'n', 0, 'a', 0,
-    'l', 0, ' ', 0, 'F', 0, 'l', 0, 'a', 0, 's', 0, 'h', 0, ' ', 0,
-    ' ', 0, '/', 0, '0', 0, 'x', 0, '0', 0, '8', 0, '0', 0, '0', 0,
-    '4', 0, '0', 0, '0', 0, '0', 0, '/', 0, '1', 0, '1', 0, '2', 0,
-    '*', 0, '0', 0, '0', 0, '1', 0, 'K', 0, 'g', 0
+    '@', 0, 'A', 0, 'p', 0, 'p', 0, 'l', 0, 'i', 0, 'c', 0, 'a', 0,
+    't', 0, 'i', 0, 'o', 0, 'n', 0,
+    DFUSE_LAYOUT(APP_BASE, APP_MAX_SIZE)
 };
 
+static const uint8_t vcom_string5[] = {
+    USB_DESC_BYTE(DFUSE_STRING_LENGTH(5)),  /* bLength                      */
+    USB_DESC_BYTE(USB_DESCRIPTOR_STRING),   /* bDescriptorType              */
+    '@', 0, 'D', 0, 'a', 0, 't', 0, 'a', 0,
+    DFUSE_LAYOUT(KV_BASE, KV_SIZE)
+};
+
+static const uint8_t vcom_string6[] = {
+    USB_DESC_BYTE(DFUSE_STRING_LENGTH(12)), /* bLength                      */
+    USB_DESC_BYTE(USB_DESCRIPTOR_STRING),   /* bDescriptorType              */
+    '@', 0, 'C', 0, 'a', 0, 'l', 0, 'i', 0, 'b', 0, 'r', 0, 'a', 0,
+    't', 0, 'i', 0, 'o', 0, 'n', 0,
+    DFUSE_LAYOUT(CAL_BASE, CAL_SIZE)
+};
+
+/* Status string (iString in DFU_GETSTATUS) for a skipped identical image */
+#define DFU_STRING_UP_TO_DATE   7
+
+static const uint8_t vcom_string7[] = {
+    USB_DESC_BYTE(38),                      /* bLength (2 + 18*2)           */
+    USB_DESC_BYTE(USB_DESCRIPTOR_STRING),   /* bDescriptorType              */
+    'A', 0, 'l', 0, 'r', 0, 'e', 0, 'a', 0, 'd', 0, 'y', 0, ' ', 0,
+    'u', 0, 'p', 0, ' ', 0, 't', 0, 'o', 0, ' ', 0, 'd', 0, 'a', 0,
+    't', 0, 'e', 0
+};
+
+_Static_assert(sizeof(vcom_string4) == DFUSE_STRING_LENGTH(12) &&
+               sizeof(vcom_string5) == DFUSE_STRING_LENGTH(5) &&
+               sizeof(vcom_string6) == DFUSE_STRING_LENGTH(12), "DFUSe string length mismatch");
+
 /**
  * @brief String Descriptors array
  */
@@ -231,9 +499,14 @@ static const USBDescriptor vcom_strings[] = {
     {sizeof vcom_string1, vcom_string1},
     {sizeof vcom_string2, vcom_string2},
     {sizeof vcom_string3, vcom_string3},
-    {sizeof vcom_string4, vcom_string4}
+    {sizeof vcom_string4, vcom_string4},
+    {sizeof vcom_string5, vcom_string5},
+    {sizeof vcom_string6, vcom_string6},
+    {sizeof vcom_string7, vcom_string7}
 };
 
+#define VCOM_NUM_STRINGS    (sizeof(vcom_strings) / sizeof(vcom_strings[0]))
+
 /*===========================================================================*/
 /* USB Driver Configuration                                                  */
 /*===========================================================================*/
@@ -254,7 +527,7 @@ static const USBDescriptor *get_descriptor(USBDriver *usbp,
     case USB_DESCRIPTOR_CONFIGURATION:
         return &vcom_configuration_descriptor;
     case USB_DESCRIPTOR_STRING:
-        if (dindex < 5)
+        if (dindex < VCOM_NUM_STRINGS)
             return &vcom_strings[dindex];
         break;
     }
@@ -277,6 +550,8 @@ static void usb_event(USBDriver *usbp, usbevent_t event) {
         /* Reset DFU state on USB reset */
         dfu_ctx.state = DFU_STATE_DFU_IDLE;
         dfu_ctx.status = DFU_STATUS_OK;
+        dfu_ctx.alt_setting = 0;
+        dfu_session_reset();
         return;
     case USB_EVENT_ADDRESS:
         return;
@@ -308,6 +583,124 @@ static const USBConfig usbcfg = {
 /* DFU Protocol Implementation                                               */
 /*===========================================================================*/
 
+/**
+ * @brief Erase flash for a request according to the partition erase policy
+ * 
+ * PART_ERASE_ALL erases the whole partition once per session.
+ * PART_ERASE_ON_TOUCH erases only the pages in [addr, addr + len) that were
+ * not erased yet in this session.
+ */
+static int dfu_partition_erase(uint32_t addr, uint32_t len) {
+    const dfu_partition_t *part = dfu_partition();
+    
+    /* Application partition touched (cancels an image check skip). The
+     * verified-image record goes first, so it never describes other data. */
+    if (part->base == APP_BASE && !dfu_ctx.app_modified) {
+        if (bootloader_forget_image() != ERR_SUCCESS) {
+            return ERR_FLASH_ERASE;
+        }
+        dfu_ctx.app_modified = true;
+    }
+    
+    /* Key/value store replaced, the bootloader's cached context is stale */
+    if (part->validate == PART_VALIDATE_KV) {
+        bootloader_kv_reload();
+    }
+    
+    if (flash_unlock() != ERR_SUCCESS) {
+        return ERR_FLASH_UNLOCK;
+    }
+    
+    if (part->erase == PART_ERASE_ALL) {
+        if (!dfu_ctx.erase_done) {
+            if (flash_erase_pages(part->base, part->size) != ERR_SUCCESS) {
+                flash_lock();
+                return ERR_FLASH_ERASE;
+            }
+            dfu_ctx.erase_done = true;
+        }
+    } else {
+        uint32_t first = (addr - part->base) / FLASH_PAGE_SIZE;
+        uint32_t last = (addr + len - 1 - part->base) / FLASH_PAGE_SIZE;
+        
+        for (uint32_t page = first; page <= last; page++) {
+            if (dfu_ctx.erased_pages[page / 32] & (1UL << (page % 32))) {
+                continue;
+            }
+            if (flash_erase_pages(part->base + page * FLASH_PAGE_SIZE, FLASH_PAGE_SIZE) != ERR_SUCCESS) {
+                flash_lock();
+                return ERR_FLASH_ERASE;
+            }
+            dfu_ctx.erased_pages[page / 32] |= (1UL << (page % 32));
+        }
+        dfu_ctx.erase_done = true;
+    }
+    
+    /* Clear ALL flash status flags after erase */
+    FLASH->SR = FLASH_SR_WRPERR | FLASH_SR_PROGERR | FLASH_SR_EOP;
+    
+    /* LOCK flash after erase (will unlock again for write) */
+    flash_lock();
+    return ERR_SUCCESS;
+}
+
+/**
+ * @brief Skip a data block of an image identical to the installed one
+ * 
+ * Decided on the first block of an application session: it must start at
+ * APP_BASE, cover the header (so version, size and CRC32 are compared) and
+ * match flash byte for byte, and the installed image must have passed its
+ * full check. Later blocks of a skipped session are compared with flash
+ * instead of programmed; a difference fails the download and leaves the
+ * installed image untouched.
+ * 
+ * @return true if the block was handled without writing
+ */
+static bool dfu_skip_block(void) {
+#ifdef USE_DFU_SKIP_IDENTICAL
+    uint32_t addr = dfu_ctx.current_address;
+    
+    if (dfu_partition()->validate != PART_VALIDATE_AT_BOOT) {
+        return false;
+    }
+    
+    bool same = dfu_partition_contains(addr, dfu_ctx.buffer_len) &&
+                memcmp((const void *)addr, dfu_ctx.buffer, dfu_ctx.buffer_len) == 0;
+    
+    if (addr == APP_BASE && !dfu_ctx.erase_done) {
+        dfu_ctx.up_to_date = same && dfu_ctx.buffer_len >= APP_HEADER_SIZE &&
+                             bootloader_app_verified();
+        if (!dfu_ctx.up_to_date) {
+            return false;
+        }
+        dfu_ctx.erase_pending = false;
+    } else if (!dfu_ctx.up_to_date) {
+        return false;
+    } else if (!same) {
+        dfu_ctx.up_to_date = false;
+        dfu_ctx.status = DFU_STATUS_ERR_VERIFY;
+        dfu_ctx.state = DFU_STATE_DFU_ERROR;
+        return true;
+    }
+    
+    dfu_ctx.current_address += dfu_ctx.buffer_len;
+    dfu_ctx.buffer_len = 0;
+    dfu_ctx.status = DFU_STATUS_OK;
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief DNLOAD data stage complete (start of the programming latency)
+ */
+static void dfu_dnload_data_cb(USBDriver *usbp) {
+    (void)usbp;
+    latency_stamp(&dfu_ctx.data_stamp);
+    dfu_ctx.data_stamped = true;
+}
+
 /**
  * @brief Process DFU_DNLOAD request
  * 
@@ -326,8 +719,16 @@ static void dfu_dnload_handler(USBDriver *usbp, uint16_t wValue, uint16_t wLengt
 
     /* Zero-length packet = download complete */
     if (wLength == 0) {
+        /* Partition validation (flash reads only, safe in ISR context) */
+        if (dfu_partition()->validate == PART_VALIDATE_KV && !kv_is_formatted()) {
+            dfu_ctx.status = DFU_STATUS_ERR_VERIFY;
+            dfu_ctx.state = DFU_STATE_DFU_ERROR;
+            usbSetupTransfer(usbp, NULL, 0, NULL);
+            return;
+        }
+        
         dfu_ctx.state = DFU_STATE_DFU_MANIFEST_SYNC;
-        dfu_ctx.download_complete = true;
+        dfu_ctx.manifest_pending = true;  /* Completed by usb_dfu_process() */
         usbSetupTransfer(usbp, NULL, 0, NULL);
         return;
     }
@@ -339,6 +740,9 @@ static void dfu_dnload_handler(USBDriver *usbp, uint16_t wValue, uint16_t wLengt
         usbStallReceiveI(usbp, 0);
         return;
     }
+    if (wLength > dfu_ctx.xfer_peak) {
+        dfu_ctx.xfer_peak = wLength;
+    }
 
     /* DFUSe special commands: wValue == 0 */
     if (wValue == 0) {
@@ -346,7 +750,7 @@ static void dfu_dnload_handler(USBDriver *usbp, uint16_t wValue, uint16_t wLengt
         dfu_ctx.block_num = 0xFFFF;  /* Sentinel value for special command */
         dfu_ctx.buffer_len = wLength;
         dfu_ctx.state = DFU_STATE_DFU_DNLOAD_SYNC;
-        usbSetupTransfer(usbp, dfu_ctx.buffer, wLength, NULL);
+        usbSetupTransfer(usbp, dfu_ctx.buffer, wLength, dfu_dnload_data_cb);
         return;
     }
 
@@ -354,7 +758,7 @@ static void dfu_dnload_handler(USBDriver *usbp, uint16_t wValue, uint16_t wLengt
     dfu_ctx.block_num = wValue;
     dfu_ctx.buffer_len = wLength;
     dfu_ctx.state = DFU_STATE_DFU_DNLOAD_SYNC;
-    usbSetupTransfer(usbp, dfu_ctx.buffer, wLength, NULL);
+    usbSetupTransfer(usbp, dfu_ctx.buffer, wLength, dfu_dnload_data_cb);
 }
 
 /**
@@ -363,14 +767,25 @@ static void dfu_dnload_handler(USBDriver *usbp, uint16_t wValue, uint16_t wLengt
 static void dfu_getstatus_handler(USBDriver *usbp) {
     static uint8_t status_response[6];
 
+    /* Host-visible DFU start-up time */
+    if (!dfu_ctx.getstatus_seen) {
+        dfu_ctx.getstatus_time = chVTGetSystemTimeX();
+        dfu_ctx.getstatus_seen = true;
+    }
+
     /* Transition state machine based on current state */
     if (dfu_ctx.state == DFU_STATE_DFU_DNLOAD_SYNC) {
         /* Flash operation in progress - transition to DNBUSY */
         
         /* Set poll timeout based on operation type */
         if (dfu_ctx.block_num == 0xFFFF) {
-            /* Special command - longer timeout for erase operations */
-            dfu_ctx.poll_timeout = 2000;  /* 2 seconds for full app erase */
+            /* Special command - longer timeout for erase operations
+             * (a deferred erase runs with the first data block) */
+            if (dfu_partition()->erase == PART_ERASE_ALL && !dfu_erase_deferred()) {
+                dfu_ctx.poll_timeout = 2000;  /* 2 seconds for full app erase */
+            } else {
+                dfu_ctx.poll_timeout = 50;    /* Single page erase */
+            }
         } else {
             /* Regular data block write - short timeout */
             dfu_ctx.poll_timeout = 10;  /* 10ms flash write */
@@ -390,7 +805,11 @@ static void dfu_getstatus_handler(USBDriver *usbp) {
         /* else: still busy, stay in DNBUSY state */
     } else if (dfu_ctx.state == DFU_STATE_DFU_MANIFEST_SYNC) {
         dfu_ctx.state = DFU_STATE_DFU_MANIFEST;
+#ifdef USE_IMAGE_SIGNATURE
+        dfu_ctx.poll_timeout = 1000;  /* Signature verification */
+#else
         dfu_ctx.poll_timeout = 0;
+#endif
     }
 
     status_response[0] = (uint8_t)dfu_ctx.status;        /* bStatus */
@@ -398,7 +817,7 @@ static void dfu_getstatus_handler(USBDriver *usbp) {
     status_response[2] = (uint8_t)((dfu_ctx.poll_timeout >> 8) & 0xFF);  /* bwPollTimeout[1] */
     status_response[3] = (uint8_t)((dfu_ctx.poll_timeout >> 16) & 0xFF); /* bwPollTimeout[2] */
     status_response[4] = (uint8_t)dfu_ctx.state;         /* bState */
-    status_response[5] = 0;                              /* iString */
+    status_response[5] = dfu_ctx.up_to_date ? DFU_STRING_UP_TO_DATE : 0;  /* iString */
 
     usbSetupTransfer(usbp, status_response, 6, NULL);
 }
@@ -430,21 +849,116 @@ static void dfu_abort_handler(USBDriver *usbp) {
     dfu_ctx.state = DFU_STATE_DFU_IDLE;
     dfu_ctx.status = DFU_STATUS_OK;
     dfu_ctx.block_num = 0;
-    dfu_ctx.current_address = APP_BASE;
-    dfu_ctx.target_address = APP_BASE;
-    dfu_ctx.erase_done = false;
+    dfu_session_reset();
     usbSetupTransfer(usbp, NULL, 0, NULL);
 }
 
+/**
+ * @brief Standard interface request hook (alternate setting selection)
+ * 
+ * ChibiOS leaves GET_INTERFACE/SET_INTERFACE to the application.
+ */
+static bool dfu_interface_hook(USBDriver *usbp) {
+    static uint8_t alt_response[1];
+    uint8_t bRequest = usbp->setup[1];
+    uint16_t wValue = (usbp->setup[3] << 8) | usbp->setup[2];
+
+    if ((usbp->setup[0] & USB_RTYPE_RECIPIENT_MASK) != USB_RTYPE_RECIPIENT_INTERFACE) {
+        return false;
+    }
+
+    switch (bRequest) {
+    case USB_REQ_GET_INTERFACE:
+        alt_response[0] = dfu_ctx.alt_setting;
+        usbSetupTransfer(usbp, alt_response, 1, NULL);
+        return true;
+
+    case USB_REQ_SET_INTERFACE:
+        /* Only allowed between transfers */
+        if (wValue >= DFU_NUM_PARTITIONS ||
+            (dfu_ctx.state != DFU_STATE_DFU_IDLE && dfu_ctx.state != DFU_STATE_DFU_ERROR)) {
+            return false;  /* STALL */
+        }
+        bootloader_timeout_reset();
+        dfu_ctx.alt_setting = (uint8_t)wValue;
+        dfu_ctx.state = DFU_STATE_DFU_IDLE;
+        dfu_ctx.status = DFU_STATUS_OK;
+        dfu_session_reset();
+        usbSetupTransfer(usbp, NULL, 0, NULL);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Vendor request hook (diagnostics, device to host)
+ * 
+ * Answered in every DFU state and does not reset the bootloader timeout.
+ */
+static bool dfu_vendor_hook(USBDriver *usbp) {
+    static union {
+        ram_stats_t ram;
+        latency_stats_t latency;
+        boot_stats_t boot;
+    } response;
+    uint8_t bRequest = usbp->setup[1];
+    uint16_t wValue = (usbp->setup[3] << 8) | usbp->setup[2];
+    uint16_t wLength = (usbp->setup[7] << 8) | usbp->setup[6];
+    size_t len;
+
+    if ((usbp->setup[0] & USB_RTYPE_DIR_MASK) != USB_RTYPE_DIR_DEV2HOST) {
+        return false;
+    }
+
+    switch (bRequest) {
+    case DFU_VENDOR_REQ_RAM_STATS:
+        ram_stats_get(&response.ram);
+        len = sizeof(response.ram);
+        break;
+
+    case DFU_VENDOR_REQ_LATENCY:
+        latency_get(&response.latency, (wValue & DFU_VENDOR_LATENCY_CLEAR) != 0);
+        len = sizeof(response.latency);
+        break;
+
+    case DFU_VENDOR_REQ_BOOT_STATS:
+        bootloader_boot_stats_get(&response.boot);
+        len = sizeof(response.boot);
+        break;
+
+    default:
+        return false;
+    }
+
+    usbSetupTransfer(usbp, (uint8_t *)&response, wLength < len ? wLength : len, NULL);
+    return true;
+}
+
 /**
  * @brief DFU Class-Specific Request Hook
  */
 static bool dfu_request_hook(USBDriver *usbp) {
+    /* Alternate setting selection (standard requests) */
+    if ((usbp->setup[0] & USB_RTYPE_TYPE_MASK) == USB_RTYPE_TYPE_STD) {
+        return dfu_interface_hook(usbp);
+    }
+    
+    /* Diagnostics */
+    if ((usbp->setup[0] & USB_RTYPE_TYPE_MASK) == USB_RTYPE_TYPE_VENDOR) {
+        return dfu_vendor_hook(usbp);
+    }
+    
     /* Handle only DFU class requests */
     if ((usbp->setup[0] & USB_RTYPE_TYPE_MASK) != USB_RTYPE_TYPE_CLASS) {
         return false;
     }
     
+    /* Request latency: setup reception to response queued */
+    latency_stamp_t stamp;
+    latency_stamp(&stamp);
+
     /* Reset bootloader timeout on any DFU activity */
     bootloader_timeout_reset();
 
@@ -455,32 +969,35 @@ static bool dfu_request_hook(USBDriver *usbp) {
     switch (bRequest) {
     case DFU_REQ_DNLOAD:
         dfu_dnload_handler(usbp, wValue, wLength);
-        return true;
+        break;
 
     case DFU_REQ_GETSTATUS:
         dfu_getstatus_handler(usbp);
-        return true;
+        break;
 
     case DFU_REQ_CLRSTATUS:
         dfu_clrstatus_handler(usbp);
-        return true;
+        break;
 
     case DFU_REQ_GETSTATE:
         dfu_getstate_handler(usbp);
-        return true;
+        break;
 
     case DFU_REQ_ABORT:
         dfu_abort_handler(usbp);
-        return true;
+        break;
 
     case DFU_REQ_DETACH:
         /* Detach not needed - already in DFU mode */
         usbSetupTransfer(usbp, NULL, 0, NULL);
-        return true;
+        break;
 
     default:
         return false;
     }
+
+    latency_record((latency_id_t)bRequest, &stamp);
+    return true;
 }
 
 /*===========================================================================*/
@@ -494,13 +1011,19 @@ int usb_dfu_init(void) {
     /* Initialize DFU context */
     dfu_ctx.state = DFU_STATE_DFU_IDLE;
     dfu_ctx.status = DFU_STATUS_OK;
-    dfu_ctx.current_address = APP_BASE;
-    dfu_ctx.target_address = APP_BASE;
+    dfu_ctx.alt_setting = 0;
+    dfu_session_reset();
     dfu_ctx.block_num = 0;
     dfu_ctx.buffer_len = 0;
+    dfu_ctx.xfer_peak = 0;
     dfu_ctx.download_complete = false;
-    dfu_ctx.erase_done = false;
+    dfu_ctx.manifest_pending = false;
+    dfu_ctx.app_modified = false;
     dfu_ctx.poll_timeout = 0;
+    dfu_ctx.getstatus_seen = false;
+    dfu_ctx.ready_done = false;
+    dfu_ctx.data_stamped = false;
+    latency_init();
 
     /* Get VID/PID from application header (or use defaults) */
     uint16_t vid, pid;
@@ -512,10 +1035,20 @@ int usb_dfu_init(void) {
     vcom_device_descriptor_data[10] = (uint8_t)(pid & 0xFF);
     vcom_device_descriptor_data[11] = (uint8_t)((pid >> 8) & 0xFF);
 
-    /* Initialize USB driver */
+    /* Initialize USB driver
+     * The pull-up is off since reset, so the disconnect pulse only needs the
+     * rest of USB_DISCONNECT_MS (system time counts from kernel start) */
     usbDisconnectBus(&USBD1);
-    chThdSleepMilliseconds(100);
+    systime_t since_boot = chVTGetSystemTimeX();
+    if (since_boot < TIME_MS2I(USB_DISCONNECT_MS)) {
+        chThdSleep(TIME_MS2I(USB_DISCONNECT_MS) - since_boot);
+    }
     usbStart(&USBD1, &usbcfg);
+    
+    /* Start of the DFU start-up time measurement (16-bit system time,
+     * accumulated in usb_dfu_process() to survive the wrap) */
+    dfu_ctx.ready_last = chVTGetSystemTimeX();
+    dfu_ctx.ready_ticks = dfu_ctx.ready_last;
     usbConnectBus(&USBD1);
 
     return ERR_SUCCESS;
@@ -526,9 +1059,47 @@ int usb_dfu_init(void) {
  * 
  * This should be called periodically in main loop to:
  * - Process DFUSe special commands (0x21 Set Address, 0x41 Erase)
- * - Write buffered firmware data to flash
+ * - Write buffered firmware data to flash and stream the image digest
+ * - Run manifestation (store verified-image record)
  */
 void usb_dfu_process(void) {
+    /* Accumulate time until the first DFU_GETSTATUS */
+    if (!dfu_ctx.ready_done) {
+        chSysLock();
+        if (dfu_ctx.getstatus_seen) {
+            dfu_ctx.ready_ticks += chTimeDiffX(dfu_ctx.ready_last, dfu_ctx.getstatus_time);
+            dfu_ctx.ready_done = true;
+        } else {
+            systime_t now = chVTGetSystemTimeX();
+            dfu_ctx.ready_ticks += chTimeDiffX(dfu_ctx.ready_last, now);
+            dfu_ctx.ready_last = now;
+        }
+        chSysUnlock();
+    }
+    
+    /* Manifestation (after zero-length download) */
+    if (dfu_ctx.manifest_pending) {
+        dfu_ctx.manifest_pending = false;
+        
+        /* Deferred erase with no data following (never for an installed image) */
+        if (dfu_ctx.erase_pending && !dfu_ctx.up_to_date) {
+            dfu_ctx.erase_pending = false;
+            if (dfu_partition_erase(dfu_partition()->base, 1) != ERR_SUCCESS) {
+                dfu_ctx.status = DFU_STATUS_ERR_ERASE;
+                dfu_ctx.state = DFU_STATE_DFU_ERROR;
+                return;
+            }
+        }
+        
+        if (dfu_manifest()) {
+            dfu_ctx.download_complete = true;
+        } else {
+            dfu_ctx.status = DFU_STATUS_ERR_VERIFY;
+            dfu_ctx.state = DFU_STATE_DFU_ERROR;
+        }
+        return;
+    }
+    
     /* Reset timeout on flash operations (activity is happening) */
     
     /* Check if we have data to process */
@@ -537,6 +1108,12 @@ void usb_dfu_process(void) {
         /* Reset timeout when processing data */
         bootloader_timeout_reset();
         
+        /* Programming latency: data stage complete to start */
+        if (dfu_ctx.data_stamped) {
+            dfu_ctx.data_stamped = false;
+            latency_record(LATENCY_PROGRAM, &dfu_ctx.data_stamp);
+        }
+        
         /* Handle DFUSe special commands (block_num == 0xFFFF) */
         if (dfu_ctx.block_num == 0xFFFF) {
             uint8_t cmd = dfu_ctx.buffer[0];
@@ -551,9 +1128,8 @@ void usb_dfu_process(void) {
                                               (dfu_ctx.buffer[3] << 16) |
                                               (dfu_ctx.buffer[4] << 24);
                     
-                    /* Validate address is in application region */
-                    if (dfu_ctx.target_address < APP_BASE || 
-                        dfu_ctx.target_address >= (APP_BASE + APP_MAX_SIZE)) {
+                    /* Validate address is in selected partition */
+                    if (!dfu_partition_contains(dfu_ctx.target_address, 1)) {
                         dfu_ctx.status = DFU_STATUS_ERR_ADDRESS;
                         dfu_ctx.state = DFU_STATE_DFU_ERROR;
                         return;
@@ -571,43 +1147,35 @@ void usb_dfu_process(void) {
                 
             case DFUSE_CMD_ERASE:  /* 0x41 - Erase Page */
                 if (dfu_ctx.buffer_len == 5) {
-                    /* Extract address (for validation, we erase entire app region) */
+                    /* Extract address (page to erase, or validation only for PART_ERASE_ALL) */
                     uint32_t erase_addr = (dfu_ctx.buffer[1] << 0)  |
                                            (dfu_ctx.buffer[2] << 8)  |
                                            (dfu_ctx.buffer[3] << 16) |
                                            (dfu_ctx.buffer[4] << 24);
                     
-                    /* Validate address is in application region */
-                    if (erase_addr < APP_BASE || 
-                        erase_addr >= (APP_BASE + APP_MAX_SIZE)) {
+                    /* Validate address is in selected partition */
+                    if (!dfu_partition_contains(erase_addr, 1)) {
                         dfu_ctx.status = DFU_STATUS_ERR_ADDRESS;
                         dfu_ctx.state = DFU_STATE_DFU_ERROR;
                         return;
                     }
                     
-                    /* Unlock flash */
-                    if (flash_unlock() != ERR_SUCCESS) {
-                        dfu_ctx.status = DFU_STATUS_ERR_PROG;
-                        dfu_ctx.state = DFU_STATE_DFU_ERROR;
-                        return;
+                    /* Erase per partition policy (whole application region only once).
+                     * Page erases between the blocks of an installed image
+                     * (dfu-util, multi-element files) are not armed. */
+                    if (dfu_erase_deferred()) {
+                        dfu_ctx.erase_pending = !dfu_ctx.erase_done && !dfu_ctx.up_to_date;
+                    } else {
+                        int result = dfu_partition_erase(erase_addr, 1);
+                        if (result != ERR_SUCCESS) {
+                            dfu_ctx.status = (result == ERR_FLASH_UNLOCK) ?
+                                             DFU_STATUS_ERR_PROG : DFU_STATUS_ERR_ERASE;
+                            dfu_ctx.state = DFU_STATE_DFU_ERROR;
+                            return;
+                        }
                     }
                     
-                    /* Erase entire application region (112KB) */
-                    if (flash_erase_pages(APP_BASE, APP_MAX_SIZE) != ERR_SUCCESS) {
-                        flash_lock();
-                        dfu_ctx.status = DFU_STATUS_ERR_ERASE;
-                        dfu_ctx.state = DFU_STATE_DFU_ERROR;
-                        return;
-                    }
-                    
-                    /* Clear ALL flash status flags after erase */
-                    FLASH->SR = FLASH_SR_WRPERR | FLASH_SR_PROGERR | FLASH_SR_EOP;
-                    
-                    /* LOCK flash after erase (will unlock again for write) */
-                    flash_lock();
-                    
-                    dfu_ctx.erase_done = true;
-                    dfu_ctx.current_address = APP_BASE;  /* Reset address for sequential writes */
+                    dfu_ctx.current_address = dfu_partition()->base;  /* Reset address for sequential writes */
                     dfu_ctx.status = DFU_STATUS_OK;
                 } else {
                     dfu_ctx.status = DFU_STATUS_ERR_STALLEDPKT;
@@ -630,38 +1198,57 @@ void usb_dfu_process(void) {
         
         /* Handle regular data blocks */
         
-        /* Auto-erase fallback on first data block (block 2) if no explicit erase */
-        if (!dfu_ctx.erase_done && dfu_ctx.block_num == 2) {
+        /* Image already installed: acknowledge without erasing or programming */
+        if (dfu_skip_block()) {
+            return;
+        }
+        
+        /* Auto-erase fallback on first data block (block 2) if no explicit erase,
+         * or the deferred erase */
+        if (!dfu_ctx.erase_done && (dfu_ctx.block_num == 2 || dfu_ctx.erase_pending) &&
+            dfu_partition()->erase == PART_ERASE_ALL) {
             /* Block 0-1 reserved for DFUSe commands, data starts at block 2 */
-            if (flash_unlock() != ERR_SUCCESS) {
-                dfu_ctx.status = DFU_STATUS_ERR_PROG;
+            int result = dfu_partition_erase(dfu_partition()->base, 1);
+            if (result != ERR_SUCCESS) {
+                dfu_ctx.status = (result == ERR_FLASH_UNLOCK) ?
+                                 DFU_STATUS_ERR_PROG : DFU_STATUS_ERR_ERASE;
                 dfu_ctx.state = DFU_STATE_DFU_ERROR;
                 return;
             }
             
-            if (flash_erase_pages(APP_BASE, APP_MAX_SIZE) != ERR_SUCCESS) {
-                flash_lock();
-                dfu_ctx.status = DFU_STATUS_ERR_ERASE;
-                dfu_ctx.state = DFU_STATE_DFU_ERROR;
-                return;
+            /* Initialize current_address for sequential writes (a deferred
+             * erase keeps the address set after the erase command) */
+            if (!dfu_ctx.erase_pending) {
+                dfu_ctx.current_address = dfu_partition()->base;
             }
-            
-            flash_lock();
-            dfu_ctx.erase_done = true;
-            /* Initialize current_address for sequential writes */
-            dfu_ctx.current_address = APP_BASE;
+            dfu_ctx.erase_pending = false;
         }
         
         /* Use current_address for write (sequential addressing) */
         uint32_t write_addr = dfu_ctx.current_address;
         
         /* Validate address range */
-        if (!flash_is_app_region(write_addr, dfu_ctx.buffer_len)) {
+        if (!dfu_partition_contains(write_addr, dfu_ctx.buffer_len)) {
             dfu_ctx.status = DFU_STATUS_ERR_ADDRESS;
             dfu_ctx.state = DFU_STATE_DFU_ERROR;
             return;
         }
         
+        if (dfu_partition()->base == APP_BASE) {
+            dfu_ctx.app_modified = true;
+        }
+        
+        /* Erase-on-touch partitions: erase pages this block lands in */
+        if (dfu_partition()->erase == PART_ERASE_ON_TOUCH) {
+            int result = dfu_partition_erase(write_addr, dfu_ctx.buffer_len);
+            if (result != ERR_SUCCESS) {
+                dfu_ctx.status = (result == ERR_FLASH_UNLOCK) ?
+                                 DFU_STATUS_ERR_PROG : DFU_STATUS_ERR_ERASE;
+                dfu_ctx.state = DFU_STATE_DFU_ERROR;
+                return;
+            }
+        }
+        
         /* Sanity check: ensure we have data to write */
         if (dfu_ctx.buffer_len == 0 || dfu_ctx.buffer_len > DFU_XFER_SIZE) {
             dfu_ctx.status = DFU_STATUS_ERR_STALLEDPKT;
@@ -687,6 +1274,13 @@ void usb_dfu_process(void) {
         /* Lock flash */
         flash_lock();
         
+        if (dfu_partition()->validate == PART_VALIDATE_KV) {
+            bootloader_kv_reload();
+        }
+        
+        /* Stream image digest */
+        dfu_hash_update(write_addr, dfu_ctx.buffer_len);
+        
         /* Advance address for next block */
         dfu_ctx.current_address += dfu_ctx.buffer_len;
 
@@ -709,3 +1303,36 @@ dfu_state_t usb_dfu_get_state(void) {
 bool usb_dfu_download_complete(void) {
     return dfu_ctx.download_complete;
 }
+
+/**
+ * @brief Check if the application partition was modified
+ */
+bool usb_dfu_app_modified(void) {
+    return dfu_ctx.app_modified;
+}
+
+/**
+ * @brief Get time from kernel start to the first DFU_GETSTATUS
+ */
+bool usb_dfu_ready_time(uint32_t *us) {
+    if (!dfu_ctx.ready_done) {
+        return false;
+    }
+    
+    *us = (uint32_t)TIME_I2US(dfu_ctx.ready_ticks);
+    return true;
+}
+
+/**
+ * @brief Check if the downloaded image matched the installed one
+ */
+bool usb_dfu_up_to_date(void) {
+    return dfu_ctx.up_to_date;
+}
+
+/**
+ * @brief Get the largest download block received
+ */
+uint16_t usb_dfu_xfer_peak(void) {
+    return dfu_ctx.xfer_peak;
+}
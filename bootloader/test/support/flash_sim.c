@@ -0,0 +1,233 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file flash_sim.c
+ * @brief RAM flash backend for host tests (implements flash_ops.h)
+ * 
+ * Follows the STM32C0 programming rules the bootloader relies on: 64-bit
+ * double-word programming into erased locations only, page erase, and
+ * programming only while unlocked. Power loss can be injected at any
+ * operation (flash_sim_cut_at()).
+ */
+
+#define _GNU_SOURCE
+#include "flash_sim.h"
+#include "flash_ops.h"
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+static uint8_t *flash;
+static uint8_t snapshot[FLASH_TOTAL_SIZE];
+static bool unlocked;
+static uint32_t op_count;
+static uint32_t cut_op;
+static flash_sim_tear_t cut_tear;
+static bool power_lost;
+
+/**
+ * @brief Count an operation, true if it is the one power is cut at
+ */
+static bool flash_sim_cut_now(void)
+{
+    op_count++;
+    if (cut_op != 0 && op_count == cut_op) {
+        power_lost = true;
+        return true;
+    }
+    
+    return false;
+}
+
+void flash_sim_init(void)
+{
+    if (flash == NULL) {
+        void *map = mmap((void *)(uintptr_t)FLASH_BASE_ADDRESS, FLASH_TOTAL_SIZE,
+                         PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                         -1, 0);
+        if (map != (void *)(uintptr_t)FLASH_BASE_ADDRESS) {
+            perror("flash_sim: cannot map flash at its target address");
+            exit(1);
+        }
+        flash = map;
+    }
+    
+    flash_sim_erase_all();
+}
+
+void flash_sim_erase_all(void)
+{
+    memset(flash, 0xFF, FLASH_TOTAL_SIZE);
+    unlocked = false;
+    flash_sim_power_on();
+}
+
+void flash_sim_save(void)
+{
+    memcpy(snapshot, flash, FLASH_TOTAL_SIZE);
+}
+
+void flash_sim_restore(void)
+{
+    memcpy(flash, snapshot, FLASH_TOTAL_SIZE);
+}
+
+void flash_sim_cut_at(uint32_t op, flash_sim_tear_t tear)
+{
+    cut_op = op;
+    cut_tear = tear;
+}
+
+bool flash_sim_power_lost(void)
+{
+    return power_lost;
+}
+
+void flash_sim_power_on(void)
+{
+    power_lost = false;
+    op_count = 0;
+    cut_op = 0;
+}
+
+uint32_t flash_sim_op_count(void)
+{
+    return op_count;
+}
+
+/**
+ * @brief Program one double-word
+ */
+static int flash_sim_program(uint32_t addr, uint32_t word1, uint32_t word2)
+{
+    if (power_lost || !unlocked) {
+        return ERR_FLASH_WRITE;
+    }
+    
+    if (addr % FLASH_WRITE_SIZE != 0 || addr < FLASH_BASE_ADDRESS ||
+        addr + FLASH_WRITE_SIZE > FLASH_END) {
+        return ERR_INVALID_ADDRESS;
+    }
+    
+    /* Programming a location that is not erased fails (PROGERR) */
+    uint32_t *dst = (uint32_t *)(uintptr_t)addr;
+    if (dst[0] != 0xFFFFFFFF || dst[1] != 0xFFFFFFFF) {
+        fprintf(stderr, "flash_sim: double-word at 0x%08X programmed twice\n", (unsigned)addr);
+        return ERR_FLASH_WRITE;
+    }
+    
+    if (flash_sim_cut_now()) {
+        if (cut_tear == FLASH_SIM_TEAR_LOW_WORD) {
+            dst[0] = word1;
+        }
+        return ERR_FLASH_WRITE;
+    }
+    
+    dst[0] = word1;
+    dst[1] = word2;
+    return ERR_SUCCESS;
+}
+
+int flash_unlock(void)
+{
+    if (power_lost) {
+        return ERR_FLASH_UNLOCK;
+    }
+    
+    unlocked = true;
+    return ERR_SUCCESS;
+}
+
+int flash_lock(void)
+{
+    unlocked = false;
+    return ERR_SUCCESS;
+}
+
+int flash_erase_pages(uint32_t addr, size_t len)
+{
+    if (power_lost || !unlocked) {
+        return ERR_FLASH_ERASE;
+    }
+    
+    if ((addr - FLASH_BASE_ADDRESS) % FLASH_PAGE_SIZE != 0 || addr < FLASH_BASE_ADDRESS ||
+        addr + len > FLASH_END) {
+        return ERR_INVALID_ADDRESS;
+    }
+    
+    for (uint32_t page = addr; page < addr + len; page += FLASH_PAGE_SIZE) {
+        if (flash_sim_cut_now()) {
+            memset((void *)(uintptr_t)page, 0xFF, FLASH_PAGE_SIZE / 2);
+            return ERR_FLASH_ERASE;
+        }
+        memset((void *)(uintptr_t)page, 0xFF, FLASH_PAGE_SIZE);
+    }
+    
+    return ERR_SUCCESS;
+}
+
+int flash_write(uint32_t addr, const uint8_t *data, size_t len)
+{
+    if (data == NULL || len == 0) {
+        return ERR_INVALID_PARAM;
+    }
+    
+    /* Partial double-word at the end is padded with the erased value */
+    for (size_t i = 0; i < len; i += FLASH_WRITE_SIZE) {
+        uint8_t buf[FLASH_WRITE_SIZE];
+        size_t n = (len - i < FLASH_WRITE_SIZE) ? len - i : FLASH_WRITE_SIZE;
+        uint32_t word1, word2;
+        
+        memset(buf, 0xFF, sizeof(buf));
+        memcpy(buf, data + i, n);
+        memcpy(&word1, &buf[0], 4);
+        memcpy(&word2, &buf[4], 4);
+        
+        int result = flash_sim_program(addr + i, word1, word2);
+        if (result != ERR_SUCCESS) {
+            return result;
+        }
+    }
+    
+    return ERR_SUCCESS;
+}
+
+int flash_write_doubleword(uint32_t addr, uint32_t word1, uint32_t word2)
+{
+    return flash_sim_program(addr, word1, word2);
+}
+
+int flash_write_word(uint32_t addr, uint32_t word)
+{
+    return flash_sim_program(addr, word, 0xFFFFFFFF);
+}
+
+bool flash_is_app_region(uint32_t addr, size_t len)
+{
+    return addr >= APP_BASE && addr < APP_END && len <= APP_END - addr;
+}
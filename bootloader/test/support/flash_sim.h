@@ -0,0 +1,89 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef FLASH_SIM_H
+#define FLASH_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief State of a double-word whose programming is cut by power loss
+ */
+typedef enum {
+    FLASH_SIM_TEAR_NONE = 0,    /* Cut before the double-word is programmed */
+    FLASH_SIM_TEAR_LOW_WORD     /* Only the low word reaches the flash */
+} flash_sim_tear_t;
+
+/**
+ * @brief Map the simulated flash at its target address and erase it
+ * 
+ * The whole flash (FLASH_BASE_ADDRESS, FLASH_TOTAL_SIZE) is mapped at the
+ * address used on the target, so flash is read through plain pointers as in
+ * the bootloader. Must be called before any flash_ops.h function.
+ */
+void flash_sim_init(void);
+
+/**
+ * @brief Erase the whole simulated flash and restore power
+ */
+void flash_sim_erase_all(void);
+
+/**
+ * @brief Save / restore a snapshot of the simulated flash
+ */
+void flash_sim_save(void);
+void flash_sim_restore(void);
+
+/**
+ * @brief Cut power at a flash operation
+ * 
+ * Every programmed double-word and every page erase counts as one operation.
+ * Operation number @p op (1-based) is interrupted: a page erase leaves the
+ * first half of the page erased, a double-word is torn according to @p tear.
+ * From then on all flash operations fail without effect, until
+ * flash_sim_power_on().
+ * 
+ * @param op Operation to interrupt, 0 = never
+ * @param tear State of an interrupted double-word
+ */
+void flash_sim_cut_at(uint32_t op, flash_sim_tear_t tear);
+
+/**
+ * @brief Check if power was cut since flash_sim_power_on()
+ */
+bool flash_sim_power_lost(void);
+
+/**
+ * @brief Restore power (reboot), counters restart at zero
+ */
+void flash_sim_power_on(void);
+
+/**
+ * @brief Number of flash operations since flash_sim_power_on()
+ */
+uint32_t flash_sim_op_count(void);
+
+#endif /* FLASH_SIM_H */
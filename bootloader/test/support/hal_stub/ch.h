@@ -0,0 +1,53 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file ch.h
+ * @brief Host stand-in for the ChibiOS kernel API used by bootloader sources
+ * 
+ * Only for host tests that compile a bootloader source using the kernel
+ * (system time, critical sections). The test provides the functions.
+ */
+
+#ifndef CH_H
+#define CH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef uint32_t systime_t;
+typedef uint32_t sysinterval_t;
+
+#define CH_CFG_ST_FREQUENCY     10000
+#define TIME_MS2I(ms)           ((sysinterval_t)(ms) * (CH_CFG_ST_FREQUENCY / 1000))
+#define TIME_I2US(interval)     ((uint32_t)(interval) * (1000000 / CH_CFG_ST_FREQUENCY))
+
+void chSysLock(void);
+void chSysUnlock(void);
+systime_t chVTGetSystemTimeX(void);
+sysinterval_t chTimeDiffX(systime_t start, systime_t end);
+void chThdSleep(sysinterval_t time);
+
+#endif /* CH_H */
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file hal.h
+ * @brief Host stand-in for the ChibiOS HAL USB driver API
+ * 
+ * Same request layout and descriptor macros as the ChibiOS USB driver. The
+ * test plays the host side: it captures the USBConfig passed to usbStart()
+ * and completes control transfers in usbSetupTransfer().
+ */
+
+#ifndef HAL_H
+#define HAL_H
+
+#include "ch.h"
+
+typedef struct USBDriver USBDriver;
+typedef void (*usbcallback_t)(USBDriver *usbp);
+
+typedef struct {
+    size_t ud_size;
+    const uint8_t *ud_string;
+} USBDescriptor;
+
+typedef enum {
+    USB_EVENT_RESET,
+    USB_EVENT_ADDRESS,
+    USB_EVENT_CONFIGURED,
+    USB_EVENT_UNCONFIGURED,
+    USB_EVENT_SUSPEND,
+    USB_EVENT_WAKEUP,
+    USB_EVENT_STALLED
+} usbevent_t;
+
+typedef struct {
+    void (*event_cb)(USBDriver *usbp, usbevent_t event);
+    const USBDescriptor *(*get_descriptor_cb)(USBDriver *usbp, uint8_t dtype,
+                                              uint8_t dindex, uint16_t lang);
+    bool (*requests_hook_cb)(USBDriver *usbp);
+    usbcallback_t sof_cb;
+} USBConfig;
+
+struct USBDriver {
+    uint8_t setup[8];                   /* Setup packet of the current request */
+};
+
+extern USBDriver USBD1;
+
+#define USB_RTYPE_DIR_MASK              0x80U
+#define USB_RTYPE_DIR_HOST2DEV          0x00U
+#define USB_RTYPE_DIR_DEV2HOST          0x80U
+#define USB_RTYPE_TYPE_MASK             0x60U
+#define USB_RTYPE_TYPE_STD              0x00U
+#define USB_RTYPE_TYPE_CLASS            0x20U
+#define USB_RTYPE_TYPE_VENDOR           0x40U
+#define USB_RTYPE_RECIPIENT_MASK        0x1FU
+#define USB_RTYPE_RECIPIENT_DEVICE      0x00U
+#define USB_RTYPE_RECIPIENT_INTERFACE   0x01U
+
+#define USB_REQ_GET_INTERFACE           10U
+#define USB_REQ_SET_INTERFACE           11U
+
+#define USB_DESCRIPTOR_DEVICE           1U
+#define USB_DESCRIPTOR_CONFIGURATION    2U
+#define USB_DESCRIPTOR_STRING           3U
+#define USB_DESCRIPTOR_INTERFACE        4U
+
+#define USB_DESC_BYTE(b)    ((uint8_t)(b))
+#define USB_DESC_WORD(w)    (uint8_t)((w) & 255U), (uint8_t)(((w) >> 8) & 255U)
+#define USB_DESC_BCD(bcd)   USB_DESC_WORD(bcd)
+
+#define USB_DESC_DEVICE(bcdUSB, bDeviceClass, bDeviceSubClass, bDeviceProtocol,   \
+                        bMaxPacketSize, idVendor, idProduct, bcdDevice,           \
+                        iManufacturer, iProduct, iSerialNumber, bNumConfigurations) \
+    USB_DESC_BYTE(18), USB_DESC_BYTE(USB_DESCRIPTOR_DEVICE), USB_DESC_BCD(bcdUSB), \
+    USB_DESC_BYTE(bDeviceClass), USB_DESC_BYTE(bDeviceSubClass),                  \
+    USB_DESC_BYTE(bDeviceProtocol), USB_DESC_BYTE(bMaxPacketSize),                \
+    USB_DESC_WORD(idVendor), USB_DESC_WORD(idProduct), USB_DESC_BCD(bcdDevice),   \
+    USB_DESC_BYTE(iManufacturer), USB_DESC_BYTE(iProduct),                        \
+    USB_DESC_BYTE(iSerialNumber), USB_DESC_BYTE(bNumConfigurations)
+
+#define USB_DESC_CONFIGURATION(wTotalLength, bNumInterfaces, bConfigurationValue, \
+                               iConfiguration, bmAttributes, bMaxPower)           \
+    USB_DESC_BYTE(9), USB_DESC_BYTE(USB_DESCRIPTOR_CONFIGURATION),                \
+    USB_DESC_WORD(wTotalLength), USB_DESC_BYTE(bNumInterfaces),                   \
+    USB_DESC_BYTE(bConfigurationValue), USB_DESC_BYTE(iConfiguration),            \
+    USB_DESC_BYTE(bmAttributes), USB_DESC_BYTE(bMaxPower)
+
+#define USB_DESC_INTERFACE(bInterfaceNumber, bAlternateSetting, bNumEndpoints,    \
+                           bInterfaceClass, bInterfaceSubClass,                   \
+                           bInterfaceProtocol, iInterface)                        \
+    USB_DESC_BYTE(9), USB_DESC_BYTE(USB_DESCRIPTOR_INTERFACE),                    \
+    USB_DESC_BYTE(bInterfaceNumber), USB_DESC_BYTE(bAlternateSetting),            \
+    USB_DESC_BYTE(bNumEndpoints), USB_DESC_BYTE(bInterfaceClass),                 \
+    USB_DESC_BYTE(bInterfaceSubClass), USB_DESC_BYTE(bInterfaceProtocol),         \
+    USB_DESC_BYTE(iInterface)
+
+void usbStart(USBDriver *usbp, const USBConfig *config);
+void usbConnectBus(USBDriver *usbp);
+void usbDisconnectBus(USBDriver *usbp);
+void usbSetupTransfer(USBDriver *usbp, uint8_t *buf, size_t n, usbcallback_t endcb);
+void usbStallReceiveI(USBDriver *usbp, uint32_t ep);
+
+#endif /* HAL_H */
@@ -0,0 +1,49 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file stm32c071xx.h
+ * @brief Host stand-in for the STM32C071 flash registers
+ * 
+ * Flash itself is simulated by flash_sim.c; the registers only absorb the
+ * status flag writes of the bootloader sources.
+ */
+
+#ifndef STM32C071XX_H
+#define STM32C071XX_H
+
+#include <stdint.h>
+
+typedef struct {
+    volatile uint32_t ACR, RESERVED0, KEYR, OPTKEYR, SR, CR;
+} FLASH_TypeDef;
+
+extern FLASH_TypeDef flash_regs;
+#define FLASH                   (&flash_regs)
+
+#define FLASH_SR_EOP            (1U << 0)
+#define FLASH_SR_PROGERR        (1U << 3)
+#define FLASH_SR_WRPERR         (1U << 4)
+
+#endif /* STM32C071XX_H */
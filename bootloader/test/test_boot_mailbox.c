@@ -0,0 +1,201 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file test_boot_mailbox.c
+ * @brief Boot mailbox tests: CRC guard, request round trip, consume once
+ * 
+ * RAM is mapped at its target address, so the mailbox is accessed at
+ * BOOT_MAILBOX_ADDR as on the target. Each test starts from RAM content
+ * that is not a valid mailbox (power-on).
+ */
+
+#define _GNU_SOURCE
+#include "unity.h"
+#include "boot_mailbox.h"
+#include "config.h"
+#include "crc32.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define MAILBOX     ((boot_mailbox_t *)BOOT_MAILBOX_ADDR)
+
+/**
+ * @brief Map RAM at its target address (once)
+ */
+static void ram_map(void)
+{
+    static bool mapped;
+    
+    if (!mapped) {
+        void *map = mmap((void *)(uintptr_t)RAM_BASE, RAM_SIZE, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (map != (void *)(uintptr_t)RAM_BASE) {
+            perror("test_boot_mailbox: cannot map RAM at its target address");
+            exit(1);
+        }
+        mapped = true;
+    }
+}
+
+/**
+ * @brief Check the CRC guard of the mailbox in RAM
+ */
+static bool crc_valid(void)
+{
+    return MAILBOX->crc == crc32_calculate((const uint8_t *)MAILBOX, offsetof(boot_mailbox_t, crc));
+}
+
+void setUp(void)
+{
+    ram_map();
+    memset((void *)BOOT_MAILBOX_ADDR, 0xA5, BOOT_MAILBOX_RESERVED);
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Invalid content is reinitialized with zero counters and no action
+ */
+void test_invalid_mailbox_initialized(void)
+{
+    mailbox_load();
+    
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_NONE, mailbox_action());
+    TEST_ASSERT_EQUAL_UINT32(0, mailbox_arg());
+    TEST_ASSERT_EQUAL_HEX32(BOOT_MAILBOX_MAGIC, MAILBOX->magic);
+    TEST_ASSERT_EQUAL_UINT16(BOOT_MAILBOX_VERSION, MAILBOX->version);
+    TEST_ASSERT_EQUAL_UINT16(sizeof(boot_mailbox_t), MAILBOX->size);
+    TEST_ASSERT_EQUAL_UINT32(1, MAILBOX->boot_count);
+    TEST_ASSERT_EQUAL_UINT32(MAILBOX_RESULT_NONE, MAILBOX->last_result);
+    TEST_ASSERT_TRUE(crc_valid());
+    
+    /* Valid from now on: counters kept */
+    mailbox_load();
+    TEST_ASSERT_EQUAL_UINT32(2, MAILBOX->boot_count);
+}
+
+/**
+ * @brief Action and argument survive the reset and are consumed once
+ */
+void test_request_round_trip(void)
+{
+    mailbox_load();
+    mailbox_request(MAILBOX_ACTION_SKIP_CHECK, 0x12345678);
+    TEST_ASSERT_TRUE(crc_valid());
+    
+    mailbox_load();
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_SKIP_CHECK, mailbox_action());
+    TEST_ASSERT_EQUAL_HEX32(0x12345678, mailbox_arg());
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_SKIP_CHECK, MAILBOX->last_action);
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_NONE, MAILBOX->action);
+    TEST_ASSERT_EQUAL_UINT32(0, MAILBOX->arg);
+    TEST_ASSERT_EQUAL_UINT32(2, MAILBOX->boot_count);
+    TEST_ASSERT_TRUE(crc_valid());
+    
+    /* Next boot: nothing requested */
+    mailbox_load();
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_NONE, mailbox_action());
+    TEST_ASSERT_EQUAL_UINT32(0, mailbox_arg());
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_NONE, MAILBOX->last_action);
+    TEST_ASSERT_EQUAL_UINT32(3, MAILBOX->boot_count);
+}
+
+/**
+ * @brief Any change not covered by the CRC discards the request
+ */
+void test_crc_guard(void)
+{
+    static const size_t corrupt[] = {
+        offsetof(boot_mailbox_t, action),
+        offsetof(boot_mailbox_t, arg),
+        offsetof(boot_mailbox_t, boot_count),
+        offsetof(boot_mailbox_t, crc),
+    };
+    
+    for (size_t i = 0; i < sizeof(corrupt) / sizeof(corrupt[0]); i++) {
+        mailbox_load();
+        mailbox_request(MAILBOX_ACTION_DFU, 5000);
+        ((uint8_t *)MAILBOX)[corrupt[i]] ^= 0x01;
+        
+        mailbox_load();
+        TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_NONE, mailbox_action());
+        TEST_ASSERT_EQUAL_UINT32(0, mailbox_arg());
+        TEST_ASSERT_EQUAL_UINT32(1, MAILBOX->boot_count);
+        TEST_ASSERT_TRUE(crc_valid());
+    }
+}
+
+/**
+ * @brief Valid CRC over a different version or size is still rejected
+ */
+void test_layout_mismatch(void)
+{
+    mailbox_load();
+    mailbox_request(MAILBOX_ACTION_DFU, 0);
+    MAILBOX->version = BOOT_MAILBOX_VERSION + 1;
+    MAILBOX->crc = crc32_calculate((const uint8_t *)MAILBOX, offsetof(boot_mailbox_t, crc));
+    
+    mailbox_load();
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_NONE, mailbox_action());
+    TEST_ASSERT_EQUAL_UINT16(BOOT_MAILBOX_VERSION, MAILBOX->version);
+    
+    mailbox_request(MAILBOX_ACTION_DFU, 0);
+    MAILBOX->size = sizeof(boot_mailbox_t) + 4;
+    MAILBOX->crc = crc32_calculate((const uint8_t *)MAILBOX, offsetof(boot_mailbox_t, crc));
+    
+    mailbox_load();
+    TEST_ASSERT_EQUAL_UINT16(MAILBOX_ACTION_NONE, mailbox_action());
+    TEST_ASSERT_EQUAL_UINT16(sizeof(boot_mailbox_t), MAILBOX->size);
+}
+
+/**
+ * @brief Result kept over the reset, the mailbox stays valid
+ */
+void test_result_kept(void)
+{
+    mailbox_load();
+    mailbox_set_result(MAILBOX_RESULT_TRUSTED);
+    TEST_ASSERT_TRUE(crc_valid());
+    
+    mailbox_load();
+    TEST_ASSERT_EQUAL_UINT32(MAILBOX_RESULT_TRUSTED, MAILBOX->last_result);
+    TEST_ASSERT_EQUAL_UINT32(2, MAILBOX->boot_count);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_invalid_mailbox_initialized);
+    RUN_TEST(test_request_round_trip);
+    RUN_TEST(test_crc_guard);
+    RUN_TEST(test_layout_mismatch);
+    RUN_TEST(test_result_kept);
+    return UNITY_END();
+}
@@ -0,0 +1,119 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file test_crc32.c
+ * @brief CRC32 and CRC32 combine tests (reference values from zlib crc32())
+ */
+
+#include "unity.h"
+#include "crc32.h"
+#include <string.h>
+
+#define DATA_LEN    3000
+
+static uint8_t data[DATA_LEN];
+
+void setUp(void)
+{
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+}
+
+void tearDown(void)
+{
+}
+
+void test_check_value(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32_calculate((const uint8_t *)"123456789", 9));
+}
+
+void test_reference_values(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(0x57081DF1, crc32_calculate(data, DATA_LEN));
+    TEST_ASSERT_EQUAL_HEX32(0x17BC2A46, crc32_calculate(data, 1000));
+    TEST_ASSERT_EQUAL_HEX32(0x3784D236, crc32_calculate(data + 1000, DATA_LEN - 1000));
+}
+
+void test_streaming_matches_one_shot(void)
+{
+    uint32_t crc = crc32_init();
+    
+    for (size_t i = 0, step = 1; i < DATA_LEN; i += step, step = step * 3 % 97 + 1) {
+        size_t n = (DATA_LEN - i < step) ? DATA_LEN - i : step;
+        crc = crc32_update(crc, data + i, n);
+    }
+    
+    TEST_ASSERT_EQUAL_HEX32(0x57081DF1, crc32_finalize(crc));
+}
+
+void test_combine_reference(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(0x57081DF1, crc32_combine(0x17BC2A46, 0x3784D236, DATA_LEN - 1000));
+}
+
+void test_combine_every_split(void)
+{
+    uint32_t whole = crc32_calculate(data, 300);
+    
+    for (size_t split = 0; split <= 300; split++) {
+        uint32_t crc_a = crc32_calculate(data, split);
+        uint32_t crc_b = crc32_calculate(data + split, 300 - split);
+        TEST_ASSERT_EQUAL_HEX32(whole, crc32_combine(crc_a, crc_b, 300 - split));
+    }
+}
+
+void test_combine_op_pages(void)
+{
+    /* Page-wise CRCs combined with one operator, as for the page table */
+    const size_t page = 256;
+    uint32_t op = crc32_combine_gen(page);
+    uint32_t crc = crc32_calculate(data, page);
+    
+    for (size_t offset = page; offset + page <= DATA_LEN; offset += page) {
+        crc = crc32_combine_op(crc, crc32_calculate(data + offset, page), op);
+        TEST_ASSERT_EQUAL_HEX32(crc32_calculate(data, offset + page), crc);
+    }
+}
+
+void test_combine_zero_length(void)
+{
+    TEST_ASSERT_EQUAL_HEX32(0x17BC2A46, crc32_combine(0x17BC2A46, crc32_calculate(data, 0), 0));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_check_value);
+    RUN_TEST(test_reference_values);
+    RUN_TEST(test_streaming_matches_one_shot);
+    RUN_TEST(test_combine_reference);
+    RUN_TEST(test_combine_every_split);
+    RUN_TEST(test_combine_op_pages);
+    RUN_TEST(test_combine_zero_length);
+    return UNITY_END();
+}
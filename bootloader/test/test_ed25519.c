@@ -0,0 +1,176 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file test_ed25519.c
+ * @brief Ed25519 verification tests (RFC 8032 section 7.1, digest message
+ *        signed with the RFC key pair using OpenSSL)
+ */
+
+#include "unity.h"
+#include "ed25519.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint8_t public_key[ED25519_PUBLIC_KEY_SIZE];
+static uint8_t signature[ED25519_SIGNATURE_SIZE];
+static uint8_t message[32];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Convert hex string to bytes
+ */
+static size_t from_hex(const char *hex, uint8_t *out, size_t max)
+{
+    size_t len = strlen(hex) / 2;
+    
+    TEST_ASSERT_TRUE(len <= max);
+    for (size_t i = 0; i < len; i++) {
+        unsigned int byte;
+        TEST_ASSERT_EQUAL_INT(1, sscanf(&hex[2 * i], "%2x", &byte));
+        out[i] = (uint8_t)byte;
+    }
+    return len;
+}
+
+/* RFC 8032 TEST 1 (empty message) */
+#define TEST1_PUBLIC_KEY    "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a"
+#define TEST1_SIGNATURE     "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b"
+
+/* RFC 8032 TEST 2 (one-byte message 0x72) */
+#define TEST2_PUBLIC_KEY    "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c"
+#define TEST2_SIGNATURE     "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00"
+
+/* TEST 2 key pair over SHA-256("abc"), as the bootloader signs image digests */
+#define DIGEST_MESSAGE      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"
+#define DIGEST_SIGNATURE    "6995e1a009aea0a390833093b5e8b43f508f46e140ddf9bb98d56a49b98870e758c93435aebaea6c3db515f8b7631c1ddf4c3d091e5443d37e5ee5773940d408"
+
+/**
+ * @brief Load the digest message vector
+ */
+static void load_digest_vector(void)
+{
+    from_hex(TEST2_PUBLIC_KEY, public_key, sizeof(public_key));
+    from_hex(DIGEST_SIGNATURE, signature, sizeof(signature));
+    from_hex(DIGEST_MESSAGE, message, sizeof(message));
+}
+
+void test_rfc8032_vectors(void)
+{
+    from_hex(TEST1_PUBLIC_KEY, public_key, sizeof(public_key));
+    from_hex(TEST1_SIGNATURE, signature, sizeof(signature));
+    TEST_ASSERT_TRUE(ed25519_verify(signature, message, 0, public_key));
+    
+    from_hex(TEST2_PUBLIC_KEY, public_key, sizeof(public_key));
+    from_hex(TEST2_SIGNATURE, signature, sizeof(signature));
+    message[0] = 0x72;
+    TEST_ASSERT_TRUE(ed25519_verify(signature, message, 1, public_key));
+    
+    /* Signature of one message does not verify another */
+    message[0] = 0x73;
+    TEST_ASSERT_FALSE(ed25519_verify(signature, message, 1, public_key));
+    TEST_ASSERT_FALSE(ed25519_verify(signature, message, 0, public_key));
+}
+
+void test_digest_message(void)
+{
+    load_digest_vector();
+    TEST_ASSERT_TRUE(ed25519_verify(signature, message, sizeof(message), public_key));
+}
+
+void test_flipped_signature_bits_rejected(void)
+{
+    load_digest_vector();
+    
+    for (size_t bit = 0; bit < 8 * ED25519_SIGNATURE_SIZE; bit++) {
+        signature[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+        TEST_ASSERT_FALSE(ed25519_verify(signature, message, sizeof(message), public_key));
+        signature[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+    }
+}
+
+void test_flipped_message_bits_rejected(void)
+{
+    load_digest_vector();
+    
+    for (size_t bit = 0; bit < 8 * sizeof(message); bit++) {
+        message[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+        TEST_ASSERT_FALSE(ed25519_verify(signature, message, sizeof(message), public_key));
+        message[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+    }
+}
+
+void test_flipped_key_bits_rejected(void)
+{
+    load_digest_vector();
+    
+    for (size_t bit = 0; bit < 8 * ED25519_PUBLIC_KEY_SIZE; bit++) {
+        public_key[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+        TEST_ASSERT_FALSE(ed25519_verify(signature, message, sizeof(message), public_key));
+        public_key[bit / 8] ^= (uint8_t)(1U << (bit % 8));
+    }
+}
+
+void test_non_canonical_scalar_rejected(void)
+{
+    /* Group order L, little-endian */
+    static const uint8_t order[32] = {
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58,
+        0xd6, 0x9c, 0xf7, 0xa2, 0xde, 0xf9, 0xde, 0x14,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+    };
+    
+    load_digest_vector();
+    
+    /* S + L is the same scalar mod L, but must not verify (malleability) */
+    unsigned int carry = 0;
+    for (size_t i = 0; i < 32; i++) {
+        carry += (unsigned int)signature[32 + i] + order[i];
+        signature[32 + i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+    TEST_ASSERT_EQUAL_UINT(0, carry);
+    TEST_ASSERT_FALSE(ed25519_verify(signature, message, sizeof(message), public_key));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_rfc8032_vectors);
+    RUN_TEST(test_digest_message);
+    RUN_TEST(test_flipped_signature_bits_rejected);
+    RUN_TEST(test_flipped_message_bits_rejected);
+    RUN_TEST(test_flipped_key_bits_rejected);
+    RUN_TEST(test_non_canonical_scalar_rejected);
+    return UNITY_END();
+}
@@ -0,0 +1,243 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file test_image_store.c
+ * @brief Image store tests on the simulated flash, with power cuts
+ * 
+ * After a power cut the entry written must read back as the old or the new
+ * value, or be gone (page erased for space), never as anything else. An
+ * erase cut short must not let entries written before it reappear.
+ */
+
+#include "unity.h"
+#include "flash_sim.h"
+#include "image_store.h"
+#include "config.h"
+#include <string.h>
+
+#define ENTRY_LEN   44      /* sizeof(image_record_t) */
+#define TABLE_LEN   216     /* page_table_t with 52 pages */
+
+void setUp(void)
+{
+    flash_sim_init();
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Fill an entry with a pattern depending on the seed
+ */
+static void fill_entry(uint8_t *buf, size_t len, uint8_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(seed * 13 + i);
+    }
+}
+
+/**
+ * @brief Write a pattern entry
+ */
+static void write_entry(uint16_t type, size_t len, uint8_t seed)
+{
+    uint8_t buf[TABLE_LEN];
+    
+    fill_entry(buf, len, seed);
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, image_store_write(type, buf, len));
+}
+
+/**
+ * @brief Check that the latest entry of a type is the pattern of @p seed
+ */
+static bool entry_is(uint16_t type, size_t len, uint8_t seed)
+{
+    uint8_t expected[TABLE_LEN];
+    uint8_t buf[TABLE_LEN];
+    size_t out_len = 0;
+    
+    fill_entry(expected, len, seed);
+    return image_store_read(type, buf, sizeof(buf), &out_len) == ERR_SUCCESS &&
+           out_len == len && memcmp(buf, expected, len) == 0;
+}
+
+void test_latest_entry_per_type(void)
+{
+    TEST_ASSERT_EQUAL_INT(ERR_NOT_FOUND, image_store_read(IMAGE_STORE_RECORD, NULL, 0, NULL));
+    
+    write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, 1);
+    write_entry(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, 1);
+    write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, 2);
+    
+    TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_RECORD, ENTRY_LEN, 2));
+    TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, 1));
+    
+    uint8_t buf[ENTRY_LEN];
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, image_store_read(IMAGE_STORE_PAGE_TABLE, buf, sizeof(buf), NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, image_store_write(IMAGE_STORE_RECORD, buf, 0));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, image_store_write(IMAGE_STORE_RECORD, buf, IMAGE_STORE_SIZE));
+}
+
+void test_unchanged_entry_not_written(void)
+{
+    write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, 1);
+    flash_sim_power_on();
+    
+    write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, 1);
+    TEST_ASSERT_EQUAL_UINT32(0, flash_sim_op_count());
+}
+
+void test_full_page_starts_over(void)
+{
+    for (uint8_t seed = 0; seed < 100; seed++) {
+        write_entry(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, seed);
+        write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, seed);
+        TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_RECORD, ENTRY_LEN, seed));
+        TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, seed) ||
+                         image_store_read(IMAGE_STORE_PAGE_TABLE, NULL, 0, NULL) == ERR_NOT_FOUND);
+    }
+}
+
+void test_erase(void)
+{
+    write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, 1);
+    write_entry(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, 1);
+    
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, image_store_erase());
+    TEST_ASSERT_EQUAL_INT(ERR_NOT_FOUND, image_store_read(IMAGE_STORE_RECORD, NULL, 0, NULL));
+    TEST_ASSERT_EQUAL_INT(ERR_NOT_FOUND, image_store_read(IMAGE_STORE_PAGE_TABLE, NULL, 0, NULL));
+    
+    /* Blank page is not erased again */
+    flash_sim_power_on();
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, image_store_erase());
+    TEST_ASSERT_EQUAL_UINT32(0, flash_sim_op_count());
+}
+
+void test_power_cut_write(void)
+{
+    static const flash_sim_tear_t tears[] = { FLASH_SIM_TEAR_NONE, FLASH_SIM_TEAR_LOW_WORD };
+    
+    /* Fill the page so that the write also has to erase it */
+    uint8_t seed = 0;
+    while (seed < 8) {
+        write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, seed++);
+        write_entry(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, seed);
+    }
+    flash_sim_save();
+    
+    for (size_t t = 0; t < sizeof(tears) / sizeof(tears[0]); t++) {
+        for (uint32_t cut = 1; ; cut++) {
+            flash_sim_restore();
+            flash_sim_power_on();
+            flash_sim_cut_at(cut, tears[t]);
+            
+            uint8_t buf[TABLE_LEN];
+            fill_entry(buf, TABLE_LEN, 0xA5);
+            int result = image_store_write(IMAGE_STORE_PAGE_TABLE, buf, TABLE_LEN);
+            
+            if (!flash_sim_power_lost()) {
+                TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, result);
+                TEST_ASSERT_TRUE(cut > 1);
+                TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, 0xA5));
+                break;
+            }
+            
+            /* Reboot: old, new or no table, record intact or gone */
+            flash_sim_power_on();
+            TEST_ASSERT_TRUE_MESSAGE(entry_is(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, seed) ||
+                                     entry_is(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, 0xA5) ||
+                                     image_store_read(IMAGE_STORE_PAGE_TABLE, NULL, 0, NULL) == ERR_NOT_FOUND,
+                                     "Table neither old, new nor gone after power cut");
+            TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_RECORD, ENTRY_LEN, seed - 1) ||
+                             image_store_read(IMAGE_STORE_RECORD, NULL, 0, NULL) == ERR_NOT_FOUND);
+            
+            /* Store still writable */
+            write_entry(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, 0xA5);
+            write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, 0xA5);
+            TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, 0xA5));
+            TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_RECORD, ENTRY_LEN, 0xA5));
+        }
+    }
+}
+
+void test_power_cut_erase(void)
+{
+    /* Entries in both halves of the page */
+    for (uint8_t seed = 0; seed < 6; seed++) {
+        write_entry(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, seed);
+        write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, seed);
+    }
+    
+    /* Interrupted erase leaves the second half, erasing again clears it */
+    flash_sim_power_on();
+    flash_sim_cut_at(1, FLASH_SIM_TEAR_NONE);
+    (void)image_store_erase();
+    TEST_ASSERT_TRUE(flash_sim_power_lost());
+    
+    flash_sim_power_on();
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, image_store_erase());
+    TEST_ASSERT_TRUE(flash_sim_op_count() > 0);
+    
+    /* Old entries never come back while the page fills up again */
+    for (uint8_t seed = 100; seed < 110; seed++) {
+        write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, seed);
+        TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_RECORD, ENTRY_LEN, seed));
+        TEST_ASSERT_EQUAL_INT(ERR_NOT_FOUND, image_store_read(IMAGE_STORE_PAGE_TABLE, NULL, 0, NULL));
+    }
+}
+
+void test_write_after_cut_erase(void)
+{
+    for (uint8_t seed = 0; seed < 6; seed++) {
+        write_entry(IMAGE_STORE_PAGE_TABLE, TABLE_LEN, seed);
+        write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, seed);
+    }
+    
+    flash_sim_power_on();
+    flash_sim_cut_at(1, FLASH_SIM_TEAR_NONE);
+    (void)image_store_erase();
+    flash_sim_power_on();
+    
+    /* Writes into the erased half must not run into the old entries */
+    for (uint8_t seed = 100; seed < 140; seed++) {
+        write_entry(IMAGE_STORE_RECORD, ENTRY_LEN, seed);
+        TEST_ASSERT_TRUE(entry_is(IMAGE_STORE_RECORD, ENTRY_LEN, seed));
+        TEST_ASSERT_EQUAL_INT(ERR_NOT_FOUND, image_store_read(IMAGE_STORE_PAGE_TABLE, NULL, 0, NULL));
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_latest_entry_per_type);
+    RUN_TEST(test_unchanged_entry_not_written);
+    RUN_TEST(test_full_page_starts_over);
+    RUN_TEST(test_erase);
+    RUN_TEST(test_power_cut_write);
+    RUN_TEST(test_power_cut_erase);
+    RUN_TEST(test_write_after_cut_erase);
+    return UNITY_END();
+}
@@ -0,0 +1,303 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file test_kv_store.c
+ * @brief Key/value store tests on the simulated flash, with power cuts
+ * 
+ * Power-cut tests replay an operation (set, overwrite, delete, garbage
+ * collection) from the same flash image, cutting power at every programmed
+ * double-word and page erase in turn. After each cut the store is
+ * initialized again (reboot) and must hold either the old or the new value
+ * of the key written, all other keys unchanged, and must accept new writes.
+ */
+
+#include "unity.h"
+#include "flash_sim.h"
+#include "kv_store.h"
+#include "config.h"
+#include <string.h>
+
+/* Record size in flash, as in kv_store.c */
+#define RECORD_SIZE(len)    (8 + (((len) + 7U) & ~7U))
+
+typedef struct {
+    size_t len;                     /* 0 = not present */
+    uint8_t data[KV_MAX_VALUE_LEN];
+} value_t;
+
+static kv_store_t kv;
+static value_t expected[KV_MAX_KEYS];
+
+void setUp(void)
+{
+    flash_sim_init();
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_init(&kv));
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Fill a value with a pattern depending on key and seed
+ */
+static void fill_value(uint8_t *buf, size_t len, uint16_t key, uint8_t seed)
+{
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(key * 31 + seed * 7 + i);
+    }
+}
+
+/**
+ * @brief Set key to a pattern value and record it as expected
+ */
+static void set_value(uint16_t key, size_t len, uint8_t seed)
+{
+    uint8_t buf[KV_MAX_VALUE_LEN];
+    
+    fill_value(buf, len, key, seed);
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_set(&kv, key, buf, len));
+    expected[key].len = len;
+    memcpy(expected[key].data, buf, len);
+}
+
+/**
+ * @brief Check that a key holds the given value (len 0 = not present)
+ */
+static bool key_holds(const kv_store_t *store, uint16_t key, const uint8_t *data, size_t len)
+{
+    uint8_t buf[KV_MAX_VALUE_LEN];
+    size_t out_len = 0;
+    int result = kv_get(store, key, buf, sizeof(buf), &out_len);
+    
+    if (len == 0) {
+        return result == ERR_NOT_FOUND;
+    }
+    
+    return result == ERR_SUCCESS && out_len == len && memcmp(buf, data, len) == 0;
+}
+
+/**
+ * @brief Check all keys except @p skip against the expected values
+ */
+static void check_expected(const kv_store_t *store, int skip)
+{
+    for (uint16_t key = 0; key < KV_MAX_KEYS; key++) {
+        if (key == skip) {
+            continue;
+        }
+        TEST_ASSERT_TRUE_MESSAGE(key_holds(store, key, expected[key].data, expected[key].len),
+                                 "Unrelated key changed");
+    }
+}
+
+/**
+ * @brief Baseline with a few keys of different lengths
+ */
+static void populate(void)
+{
+    memset(expected, 0, sizeof(expected));
+    set_value(0, 1, 1);
+    set_value(1, 4, 1);
+    set_value(7, 13, 1);
+    set_value(20, 64, 1);
+    set_value(KV_MAX_KEYS - 1, 200, 1);
+}
+
+/**
+ * @brief Overwrite a key until the next write of @p len needs garbage collection
+ */
+static void fill_page(size_t len)
+{
+    uint8_t seed = 2;
+    
+    while (kv.write_offset + RECORD_SIZE(len) <= FLASH_PAGE_SIZE) {
+        set_value(3, 24, seed++);
+    }
+}
+
+/**
+ * @brief Replay a write or delete with a power cut at every flash operation
+ * 
+ * @param key Key written
+ * @param len New value length, 0 = delete
+ */
+static void check_power_cuts(uint16_t key, size_t len)
+{
+    static const flash_sim_tear_t tears[] = { FLASH_SIM_TEAR_NONE, FLASH_SIM_TEAR_LOW_WORD };
+    uint8_t value[KV_MAX_VALUE_LEN];
+    value_t old = expected[key];
+    
+    fill_value(value, len, key, 0xA5);
+    flash_sim_save();
+    
+    for (size_t t = 0; t < sizeof(tears) / sizeof(tears[0]); t++) {
+        for (uint32_t cut = 1; ; cut++) {
+            kv_store_t store;
+            
+            flash_sim_restore();
+            flash_sim_power_on();
+            TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_init(&store));
+            flash_sim_cut_at(cut, tears[t]);
+            
+            int result = (len > 0) ? kv_set(&store, key, value, len) : kv_delete(&store, key);
+            
+            if (!flash_sim_power_lost()) {
+                /* Operation completed before the cut: done with this tear mode */
+                TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, result);
+                TEST_ASSERT_TRUE(cut > 1);
+                TEST_ASSERT_TRUE(key_holds(&store, key, value, len));
+                check_expected(&store, key);
+                break;
+            }
+            
+            /* Reboot: old or new value, nothing else changed */
+            flash_sim_power_on();
+            TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_init(&store));
+            TEST_ASSERT_TRUE_MESSAGE(key_holds(&store, key, old.data, old.len) ||
+                                     key_holds(&store, key, value, len),
+                                     "Key neither old nor new after power cut");
+            check_expected(&store, key);
+            
+            /* Store still writable, and the write survives the next reboot */
+            result = (len > 0) ? kv_set(&store, key, value, len) : kv_delete(&store, key);
+            TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, result);
+            TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_init(&store));
+            TEST_ASSERT_TRUE(key_holds(&store, key, value, len));
+            check_expected(&store, key);
+        }
+    }
+}
+
+void test_set_get_persist(void)
+{
+    populate();
+    
+    kv_store_t store;
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_init(&store));
+    check_expected(&store, -1);
+}
+
+void test_invalid_parameters(void)
+{
+    uint8_t buf[KV_MAX_VALUE_LEN + 1] = {0};
+    
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, kv_set(&kv, KV_MAX_KEYS, buf, 1));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, kv_set(&kv, 0, buf, 0));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, kv_set(&kv, 0, buf, KV_MAX_VALUE_LEN + 1));
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, kv_delete(&kv, KV_MAX_KEYS));
+    TEST_ASSERT_EQUAL_INT(ERR_NOT_FOUND, kv_get(&kv, 0, buf, sizeof(buf), NULL));
+    
+    set_value(0, 16, 1);
+    TEST_ASSERT_EQUAL_INT(ERR_INVALID_PARAM, kv_get(&kv, 0, buf, 8, NULL));
+}
+
+void test_unchanged_value_not_written(void)
+{
+    populate();
+    flash_sim_power_on();
+    
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_set(&kv, 20, expected[20].data, expected[20].len));
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_delete(&kv, 2));
+    TEST_ASSERT_EQUAL_UINT32(0, flash_sim_op_count());
+}
+
+void test_delete(void)
+{
+    populate();
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_delete(&kv, 7));
+    expected[7].len = 0;
+    
+    kv_store_t store;
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_init(&store));
+    check_expected(&store, -1);
+}
+
+void test_gc_keeps_live_values(void)
+{
+    populate();
+    
+    /* Several collections, alternating between both pages */
+    for (uint8_t seed = 0; seed < 200; seed++) {
+        set_value(3, 100, seed);
+    }
+    
+    kv_store_t store;
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, kv_init(&store));
+    TEST_ASSERT_TRUE(store.sequence > 2);
+    check_expected(&store, -1);
+}
+
+void test_power_cut_set_new_key(void)
+{
+    populate();
+    check_power_cuts(5, 37);
+}
+
+void test_power_cut_overwrite(void)
+{
+    populate();
+    check_power_cuts(20, 64);
+}
+
+void test_power_cut_delete(void)
+{
+    populate();
+    check_power_cuts(7, 0);
+}
+
+void test_power_cut_gc(void)
+{
+    populate();
+    fill_page(KV_MAX_VALUE_LEN);
+    check_power_cuts(KV_MAX_KEYS - 1, KV_MAX_VALUE_LEN);
+}
+
+void test_power_cut_gc_into_used_page(void)
+{
+    /* Second collection erases the page that still holds the older log */
+    populate();
+    fill_page(KV_MAX_VALUE_LEN);
+    set_value(4, KV_MAX_VALUE_LEN, 1);
+    fill_page(48);
+    check_power_cuts(4, 48);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_set_get_persist);
+    RUN_TEST(test_invalid_parameters);
+    RUN_TEST(test_unchanged_value_not_written);
+    RUN_TEST(test_delete);
+    RUN_TEST(test_gc_keeps_live_values);
+    RUN_TEST(test_power_cut_set_new_key);
+    RUN_TEST(test_power_cut_overwrite);
+    RUN_TEST(test_power_cut_delete);
+    RUN_TEST(test_power_cut_gc);
+    RUN_TEST(test_power_cut_gc_into_used_page);
+    return UNITY_END();
+}
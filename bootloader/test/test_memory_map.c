@@ -0,0 +1,156 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file test_memory_map.c
+ * @brief Memory map checks, built once per target (inc/targets/<target>/target.h)
+ * 
+ * The linker region sizes (LD_bl_*) are the --defsym expressions of the
+ * bootloader Makefile and the region origins (LD_*_ORIGIN) those of the
+ * bootloader linker script, both passed in by the test Makefile. LD_APP_*
+ * are the regions of the template application linker script of the target
+ * and APP_BL_SERVICES_ADDR the service table address of its header.
+ */
+
+#include "unity.h"
+#include "config.h"
+#include "bootloader.h"
+#include "page_table.h"
+
+#if !defined(LD_bl_flash_size) || !defined(LD_bl_services_size) || !defined(LD_bl_ram_size) || \
+    !defined(LD_FLASH_ORIGIN) || !defined(LD_RAM_ORIGIN)
+#error "Linker script values not passed in (see test/Makefile)"
+#endif
+
+#if !defined(LD_APP_FLASH_ORIGIN) || !defined(LD_APP_FLASH_SIZE) || !defined(LD_APP_RAM_ORIGIN) || \
+    !defined(LD_APP_RAM_SIZE) || !defined(APP_BL_SERVICES_ADDR)
+#error "Application linker script values not passed in (see test/Makefile)"
+#endif
+
+/* Image store entry: 8-byte header, data padded to double-words */
+#define STORE_ENTRY_SIZE(len)   (8U + (((len) + 7U) & ~7U))
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void assert_page_aligned(uint32_t base, uint32_t size)
+{
+    TEST_ASSERT_EQUAL_UINT32(0, base % FLASH_PAGE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(0, size % FLASH_PAGE_SIZE);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, size);
+}
+
+void test_partitions_in_order(void)
+{
+    /* Bootloader, application, image store, calibration, key/value store */
+    TEST_ASSERT_EQUAL_HEX32(FLASH_BASE_ADDRESS, BOOTLOADER_BASE);
+    TEST_ASSERT_EQUAL_HEX32(BOOTLOADER_BASE + BOOTLOADER_SIZE, APP_BASE);
+    TEST_ASSERT_EQUAL_HEX32(APP_BASE + APP_MAX_SIZE, APP_END);
+    TEST_ASSERT_EQUAL_HEX32(APP_END, IMAGE_STORE_BASE);
+    TEST_ASSERT_EQUAL_HEX32(IMAGE_STORE_BASE + IMAGE_STORE_SIZE, CAL_BASE);
+    TEST_ASSERT_EQUAL_HEX32(CAL_BASE + CAL_SIZE, KV_BASE);
+    TEST_ASSERT_EQUAL_HEX32(KV_BASE + KV_SIZE, FLASH_END);
+    TEST_ASSERT_EQUAL_HEX32(FLASH_BASE_ADDRESS + TARGET_FLASH_SIZE, FLASH_END);
+}
+
+void test_partitions_page_aligned(void)
+{
+    assert_page_aligned(BOOTLOADER_BASE, BOOTLOADER_SIZE);
+    assert_page_aligned(APP_BASE, APP_MAX_SIZE);
+    assert_page_aligned(IMAGE_STORE_BASE, IMAGE_STORE_SIZE);
+    assert_page_aligned(CAL_BASE, CAL_SIZE);
+    assert_page_aligned(KV_BASE, KV_SIZE);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(KV_PAGES, 2); /* Garbage collection needs two pages */
+}
+
+void test_application_layout(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(0, APP_BASE % APP_VECTOR_ALIGNMENT);
+    TEST_ASSERT_EQUAL_UINT32(0, (APP_BASE + APP_VECTOR_TABLE_OFFSET) % APP_VECTOR_ALIGNMENT);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(APP_VECTOR_TABLE_OFFSET, APP_HEADER_SIZE);
+    TEST_ASSERT_GREATER_THAN_UINT32(APP_VECTOR_TABLE_OFFSET, APP_MAX_SIZE);
+
+    /* DFUSe layout strings: whole pages, at most 3 digits each */
+    TEST_ASSERT_EQUAL_UINT32(0, FLASH_PAGE_SIZE % 1024);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(999, APP_MAX_SIZE / FLASH_PAGE_SIZE);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(999, FLASH_PAGE_SIZE / 1024);
+}
+
+void test_image_store_fits(void)
+{
+    /* Page table of the largest image and a verified-image record */
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(PAGE_TABLE_MAX_PAGES, page_table_pages(APP_MAX_SIZE - APP_VECTOR_TABLE_OFFSET));
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(IMAGE_STORE_SIZE,
+                                     STORE_ENTRY_SIZE(sizeof(page_table_t)) +
+                                     STORE_ENTRY_SIZE(sizeof(image_record_t)));
+}
+
+void test_linker_flash_regions(void)
+{
+    /* flash0: bootloader code, flash_svc: service table up to the application */
+    TEST_ASSERT_EQUAL_HEX32(BOOTLOADER_BASE, LD_FLASH_ORIGIN);
+    TEST_ASSERT_EQUAL_HEX32(BL_SERVICES_ADDR, LD_FLASH_ORIGIN + LD_bl_flash_size);
+    TEST_ASSERT_EQUAL_UINT32(BL_SERVICES_SIZE, LD_bl_services_size);
+    TEST_ASSERT_EQUAL_HEX32(APP_BASE, LD_FLASH_ORIGIN + LD_bl_flash_size + LD_bl_services_size);
+    TEST_ASSERT_EQUAL_UINT32(0, LD_bl_flash_size % 4);
+}
+
+void test_linker_ram_region(void)
+{
+    /* ram0 ends at the boot mailbox, the magic word is its last word */
+    TEST_ASSERT_EQUAL_HEX32(RAM_BASE, LD_RAM_ORIGIN);
+    TEST_ASSERT_EQUAL_HEX32(BOOT_MAILBOX_ADDR, LD_RAM_ORIGIN + LD_bl_ram_size);
+    TEST_ASSERT_EQUAL_HEX32(RAM_BASE + TARGET_RAM_SIZE, BOOT_MAILBOX_ADDR + BOOT_MAILBOX_RESERVED);
+    TEST_ASSERT_EQUAL_HEX32(RAM_BASE + RAM_SIZE - 4, BOOTLOADER_MAGIC_ADDR);
+    TEST_ASSERT_EQUAL_UINT32(0, LD_bl_ram_size % 8);
+}
+
+void test_application_linker_script(void)
+{
+    /* Code from the vector table up to the image store, ram0 below the mailbox */
+    TEST_ASSERT_EQUAL_HEX32(APP_BASE + APP_VECTOR_TABLE_OFFSET, LD_APP_FLASH_ORIGIN);
+    TEST_ASSERT_EQUAL_HEX32(APP_END, LD_APP_FLASH_ORIGIN + LD_APP_FLASH_SIZE);
+    TEST_ASSERT_EQUAL_HEX32(RAM_BASE, LD_APP_RAM_ORIGIN);
+    TEST_ASSERT_EQUAL_HEX32(BOOT_MAILBOX_ADDR, LD_APP_RAM_ORIGIN + LD_APP_RAM_SIZE);
+    TEST_ASSERT_EQUAL_HEX32(BL_SERVICES_ADDR, APP_BL_SERVICES_ADDR);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_partitions_in_order);
+    RUN_TEST(test_partitions_page_aligned);
+    RUN_TEST(test_application_layout);
+    RUN_TEST(test_image_store_fits);
+    RUN_TEST(test_linker_flash_regions);
+    RUN_TEST(test_linker_ram_region);
+    RUN_TEST(test_application_linker_script);
+    return UNITY_END();
+}
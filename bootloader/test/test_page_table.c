@@ -0,0 +1,168 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file test_page_table.c
+ * @brief Per-page CRC32 table tests on an image in the simulated flash
+ */
+
+#include "unity.h"
+#include "flash_sim.h"
+#include "page_table.h"
+#include "crc32.h"
+#include <string.h>
+
+/* Largest image accepted by bootloader_validate_app() */
+#define IMAGE_MAX_SIZE  (APP_MAX_SIZE - APP_VECTOR_TABLE_OFFSET)
+
+static uint8_t *const image = (uint8_t *)(APP_BASE + APP_VECTOR_TABLE_OFFSET);
+
+/* Table followed by a guard, an overflow of page_crc[] changes it */
+static struct {
+    page_table_t table;
+    uint32_t guard[4];
+} t;
+
+void setUp(void)
+{
+    flash_sim_init();
+    memset(t.guard, 0xA5, sizeof(t.guard));
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Write a pattern image to the application region
+ * 
+ * @return Image CRC32 as in the header
+ */
+static uint32_t write_image(uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++) {
+        image[i] = (uint8_t)(i * 7 + (i >> 11));
+    }
+    return crc32_calculate(image, size);
+}
+
+/**
+ * @brief Check that the table guard is untouched
+ */
+static void check_guard(void)
+{
+    for (size_t i = 0; i < sizeof(t.guard) / sizeof(t.guard[0]); i++) {
+        TEST_ASSERT_EQUAL_HEX32(0xA5A5A5A5, t.guard[i]);
+    }
+}
+
+void test_page_count(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(1, page_table_pages(1));
+    TEST_ASSERT_EQUAL_UINT32(1, page_table_pages(FLASH_PAGE_SIZE - APP_VECTOR_TABLE_OFFSET));
+    TEST_ASSERT_EQUAL_UINT32(2, page_table_pages(FLASH_PAGE_SIZE - APP_VECTOR_TABLE_OFFSET + 1));
+    TEST_ASSERT_EQUAL_UINT32(PAGE_TABLE_MAX_PAGES, page_table_pages(IMAGE_MAX_SIZE));
+}
+
+void test_largest_image_fits(void)
+{
+    uint32_t crc = write_image(IMAGE_MAX_SIZE);
+    size_t len = page_table_build(&t.table, IMAGE_MAX_SIZE, crc);
+    
+    TEST_ASSERT_EQUAL_UINT32(sizeof(page_table_t), len);
+    check_guard();
+    TEST_ASSERT_TRUE(page_table_valid(&t.table, len, IMAGE_MAX_SIZE, crc));
+    
+    uint8_t cursor = 1;
+    TEST_ASSERT_TRUE(page_table_check(&t.table, &cursor, PAGE_TABLE_MAX_PAGES));
+}
+
+void test_table_bound_to_header(void)
+{
+    uint32_t size = 5 * FLASH_PAGE_SIZE + 100;
+    uint32_t crc = write_image(size);
+    size_t len = page_table_build(&t.table, size, crc);
+    
+    TEST_ASSERT_TRUE(page_table_valid(&t.table, len, size, crc));
+    TEST_ASSERT_FALSE(page_table_valid(&t.table, len, size, crc ^ 1));
+    TEST_ASSERT_FALSE(page_table_valid(&t.table, len, size + 1, crc));
+    TEST_ASSERT_FALSE(page_table_valid(&t.table, len - 4, size, crc));
+    
+    /* Entries must combine to the image CRC32 */
+    t.table.page_crc[3] ^= 1;
+    TEST_ASSERT_FALSE(page_table_valid(&t.table, len, size, crc));
+}
+
+void test_rotation_covers_image(void)
+{
+    uint32_t size = 20 * FLASH_PAGE_SIZE;
+    uint32_t crc = write_image(size);
+    size_t len = page_table_build(&t.table, size, crc);
+    uint32_t pages = page_table_pages(size);
+    TEST_ASSERT_TRUE(page_table_valid(&t.table, len, size, crc));
+    
+    /* Damaged page found once the rotation reaches it */
+    image[15 * FLASH_PAGE_SIZE] ^= 0x01;
+    
+    uint8_t cursor = 0;
+    uint32_t boots = 0;
+    while (page_table_check(&t.table, &cursor, 4)) {
+        boots++;
+        TEST_ASSERT_TRUE(cursor >= 1 && cursor < pages);
+        TEST_ASSERT_TRUE(boots <= (pages - 1 + 3) / 4);
+    }
+    
+    /* Vector table page is checked on every boot */
+    image[15 * FLASH_PAGE_SIZE] ^= 0x01;
+    image[0] ^= 0x01;
+    cursor = 1;
+    TEST_ASSERT_FALSE(page_table_check(&t.table, &cursor, 4));
+}
+
+void test_cursor_out_of_range_restarts(void)
+{
+    uint32_t size = 3 * FLASH_PAGE_SIZE;
+    uint32_t crc = write_image(size);
+    (void)page_table_build(&t.table, size, crc);
+    
+    uint8_t cursor = 200;
+    TEST_ASSERT_TRUE(page_table_check(&t.table, &cursor, 1));
+    TEST_ASSERT_EQUAL_UINT8(2, cursor);
+    
+    /* More pages per boot than the image has */
+    cursor = 1;
+    TEST_ASSERT_TRUE(page_table_check(&t.table, &cursor, 100));
+    TEST_ASSERT_EQUAL_UINT8(1, cursor);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_page_count);
+    RUN_TEST(test_largest_image_fits);
+    RUN_TEST(test_table_bound_to_header);
+    RUN_TEST(test_rotation_covers_image);
+    RUN_TEST(test_cursor_out_of_range_restarts);
+    return UNITY_END();
+}
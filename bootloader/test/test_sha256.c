@@ -0,0 +1,142 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file test_sha256.c
+ * @brief SHA-256 tests (FIPS 180-2 examples, other values from Python hashlib)
+ */
+
+#include "unity.h"
+#include "sha256.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DATA_LEN    3000
+
+static uint8_t data[DATA_LEN];
+
+void setUp(void)
+{
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Compare digest with a hex string
+ */
+static void check_digest(const char *hex, const uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    char text[2 * SHA256_DIGEST_SIZE + 1];
+    
+    for (size_t i = 0; i < SHA256_DIGEST_SIZE; i++) {
+        snprintf(&text[2 * i], 3, "%02x", digest[i]);
+    }
+    TEST_ASSERT_EQUAL_STRING(hex, text);
+}
+
+void test_fips_examples(void)
+{
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    
+    sha256_calculate((const uint8_t *)"", 0, digest);
+    check_digest("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", digest);
+    
+    sha256_calculate((const uint8_t *)"abc", 3, digest);
+    check_digest("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", digest);
+    
+    const char *two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    sha256_calculate((const uint8_t *)two_blocks, strlen(two_blocks), digest);
+    check_digest("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", digest);
+}
+
+void test_million_a(void)
+{
+    uint8_t block[1000];
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    sha256_ctx_t ctx;
+    
+    memset(block, 'a', sizeof(block));
+    sha256_init(&ctx);
+    for (int i = 0; i < 1000; i++) {
+        sha256_update(&ctx, block, sizeof(block));
+    }
+    sha256_final(&ctx, digest);
+    check_digest("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0", digest);
+}
+
+void test_padding_boundaries(void)
+{
+    static const struct {
+        size_t len;
+        const char *hex;
+    } vectors[] = {
+    {   55, "e7313d333c272e639f790978283f9eb392e843d0f29b7016828bb1daa4aac70b" },
+    {   56, "4324d65f3c103567f5589c710bc08f8523f929a9272e3af36fc968e52abc6c27" },
+    {   63, "81c80242132f230c3bd41b3e63bbcff16107339549214a99614ff26664625055" },
+    {   64, "39e3d7b6b5d075d37d053ad89b24b41bef4f3c29760c84447cab3f3be1882241" },
+    {   65, "aacca6ff74fdbb296d165a45cecfa04e5127bc008770fbbdd48006f2d2fae95e" },
+    { 3000, "f541874101876255b4baf3a739778d04cb9cba25ffa38b30bc1fb8b0701f2a45" },
+    };
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    
+    for (size_t i = 0; i < sizeof(vectors) / sizeof(vectors[0]); i++) {
+        sha256_calculate(data, vectors[i].len, digest);
+        check_digest(vectors[i].hex, digest);
+    }
+}
+
+void test_streaming_matches_one_shot(void)
+{
+    uint8_t expected[SHA256_DIGEST_SIZE];
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    
+    sha256_calculate(data, DATA_LEN, expected);
+    
+    /* Chunk sizes around the block size, as DFU blocks arrive */
+    for (size_t step = 1; step <= 2 * SHA256_BLOCK_SIZE + 1; step++) {
+        sha256_ctx_t ctx;
+        sha256_init(&ctx);
+        for (size_t i = 0; i < DATA_LEN; i += step) {
+            sha256_update(&ctx, data + i, (DATA_LEN - i < step) ? DATA_LEN - i : step);
+        }
+        sha256_final(&ctx, digest);
+        TEST_ASSERT_EQUAL_MEMORY(expected, digest, SHA256_DIGEST_SIZE);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fips_examples);
+    RUN_TEST(test_million_a);
+    RUN_TEST(test_padding_boundaries);
+    RUN_TEST(test_streaming_matches_one_shot);
+    return UNITY_END();
+}
@@ -0,0 +1,329 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file test_usb_dfu.c
+ * @brief DFU download tests (identical image skip, data partition)
+ * 
+ * Drives the real usb_dfu.c through a host-side USB layer (support/hal_stub)
+ * with the request sequences of dfu-util's DfuSe download: a page erase
+ * before each new page, a set address and the data blocks. A session that
+ * matches the installed image must leave the application flash untouched.
+ */
+
+#include "unity.h"
+#include "flash_sim.h"
+#include "flash_ops.h"
+#include "usb_dfu.h"
+#include "bootloader.h"
+#include "latency.h"
+#include "ram_stats.h"
+#include "config.h"
+#include "hal.h"
+#include "stm32c071xx.h"
+#include <string.h>
+
+#define IMAGE_SIZE      (3 * FLASH_PAGE_SIZE)
+
+USBDriver USBD1;
+FLASH_TypeDef flash_regs;
+
+static const USBConfig *usb_config;
+static const uint8_t *host_out;         /* Data stage of the next host to device request */
+static uint8_t host_in[64];             /* Data stage of the last device to host request */
+static bool app_verified;
+static int forget_calls;
+static int kv_reload_calls;
+static uint8_t image[IMAGE_SIZE];
+
+/*===========================================================================*/
+/* Bootloader, kernel and USB driver stand-ins                               */
+/*===========================================================================*/
+
+bool bootloader_app_verified(void) { return app_verified; }
+void bootloader_boot_stats_get(boot_stats_t *stats) { memset(stats, 0, sizeof(*stats)); }
+int bootloader_record_image(const uint8_t digest[SHA256_DIGEST_SIZE]) { (void)digest; return ERR_SUCCESS; }
+void bootloader_timeout_reset(void) { }
+void bootloader_kv_reload(void) { kv_reload_calls++; }
+
+int bootloader_forget_image(void)
+{
+    forget_calls++;
+    return ERR_SUCCESS;
+}
+
+void latency_init(void) { }
+void latency_stamp(latency_stamp_t *stamp) { memset(stamp, 0, sizeof(*stamp)); }
+void latency_record(latency_id_t id, const latency_stamp_t *stamp) { (void)id; (void)stamp; }
+void latency_get(latency_stats_t *stats, bool clear) { (void)clear; memset(stats, 0, sizeof(*stats)); }
+void ram_stats_get(ram_stats_t *stats) { memset(stats, 0, sizeof(*stats)); }
+
+void chSysLock(void) { }
+void chSysUnlock(void) { }
+systime_t chVTGetSystemTimeX(void) { return TIME_MS2I(USB_DISCONNECT_MS); }
+sysinterval_t chTimeDiffX(systime_t start, systime_t end) { return end - start; }
+void chThdSleep(sysinterval_t time) { (void)time; }
+
+void usbStart(USBDriver *usbp, const USBConfig *config) { (void)usbp; usb_config = config; }
+void usbConnectBus(USBDriver *usbp) { (void)usbp; }
+void usbDisconnectBus(USBDriver *usbp) { (void)usbp; }
+void usbStallReceiveI(USBDriver *usbp, uint32_t ep) { (void)usbp; (void)ep; }
+
+/**
+ * @brief Complete a control transfer (data stage, then the end callback)
+ */
+void usbSetupTransfer(USBDriver *usbp, uint8_t *buf, size_t n, usbcallback_t endcb)
+{
+    if ((usbp->setup[0] & USB_RTYPE_DIR_MASK) == USB_RTYPE_DIR_DEV2HOST) {
+        TEST_ASSERT_TRUE(n <= sizeof(host_in));
+        memcpy(host_in, buf, n);
+    } else if (n > 0) {
+        memcpy(buf, host_out, n);
+    }
+    
+    if (endcb != NULL) {
+        endcb(usbp);
+    }
+}
+
+/*===========================================================================*/
+/* Host side                                                                 */
+/*===========================================================================*/
+
+/**
+ * @brief Send a control request, which the DFU request hook must accept
+ */
+static void control(uint8_t type, uint8_t request, uint16_t value, const uint8_t *data, uint16_t len)
+{
+    uint8_t setup[8] = {type, request, (uint8_t)value, (uint8_t)(value >> 8),
+                        0, 0, (uint8_t)len, (uint8_t)(len >> 8)};
+    
+    memcpy(USBD1.setup, setup, sizeof(setup));
+    host_out = data;
+    TEST_ASSERT_TRUE(usb_config->requests_hook_cb(&USBD1));
+}
+
+/**
+ * @brief DFU_GETSTATUS, returns bState
+ */
+static uint8_t get_status(void)
+{
+    control(USB_RTYPE_DIR_DEV2HOST | USB_RTYPE_TYPE_CLASS | USB_RTYPE_RECIPIENT_INTERFACE,
+            DFU_REQ_GETSTATUS, 0, NULL, 6);
+    
+    return host_in[4];
+}
+
+/**
+ * @brief DFU_DNLOAD a block and poll until it is processed, returns bState
+ */
+static uint8_t dnload(uint16_t block, const uint8_t *data, uint16_t len)
+{
+    control(USB_RTYPE_DIR_HOST2DEV | USB_RTYPE_TYPE_CLASS | USB_RTYPE_RECIPIENT_INTERFACE,
+            DFU_REQ_DNLOAD, block, data, len);
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNBUSY, get_status());
+    usb_dfu_process();
+    
+    return get_status();
+}
+
+/**
+ * @brief DfuSe command (set address or erase page)
+ */
+static uint8_t dfuse_command(uint8_t command, uint32_t addr)
+{
+    uint8_t cmd[5] = {command, (uint8_t)addr, (uint8_t)(addr >> 8),
+                      (uint8_t)(addr >> 16), (uint8_t)(addr >> 24)};
+    
+    return dnload(0, cmd, sizeof(cmd));
+}
+
+/**
+ * @brief Download the image like dfu-util: page erase, set address, blocks
+ * 
+ * dfu-util numbers every block after a set address as block 2.
+ */
+static uint8_t download(const uint8_t *data, uint32_t size)
+{
+    uint8_t state = DFU_STATE_DFU_DNLOAD_IDLE;
+    
+    for (uint32_t offset = 0; offset < size && state == DFU_STATE_DFU_DNLOAD_IDLE;
+         offset += DFU_XFER_SIZE) {
+        if (offset % FLASH_PAGE_SIZE == 0) {
+            TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE,
+                                    dfuse_command(DFUSE_CMD_ERASE, APP_BASE + offset));
+        }
+        TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE,
+                                dfuse_command(DFUSE_CMD_SET_ADDRESS, APP_BASE + offset));
+        state = dnload(2, data + offset, DFU_XFER_SIZE);
+    }
+    
+    return state;
+}
+
+/**
+ * @brief Zero-length DFU_DNLOAD and manifestation
+ */
+static void manifest(void)
+{
+    control(USB_RTYPE_DIR_HOST2DEV | USB_RTYPE_TYPE_CLASS | USB_RTYPE_RECIPIENT_INTERFACE,
+            DFU_REQ_DNLOAD, 0, NULL, 0);
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_MANIFEST, get_status());
+    usb_dfu_process();
+}
+
+/*===========================================================================*/
+/* Tests                                                                     */
+/*===========================================================================*/
+
+void setUp(void)
+{
+    app_header_t header = {
+        .magic = APP_HEADER_MAGIC,
+        .version = 1,
+        .size = IMAGE_SIZE - APP_VECTOR_TABLE_OFFSET,
+    };
+    
+    for (size_t i = 0; i < sizeof(image); i++) {
+        image[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+    memcpy(image, &header, sizeof(header));
+    
+    /* Installed image */
+    flash_sim_init();
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, flash_unlock());
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, flash_write(APP_BASE, image, sizeof(image)));
+    flash_lock();
+    
+    app_verified = true;
+    forget_calls = 0;
+    kv_reload_calls = 0;
+    TEST_ASSERT_EQUAL_INT(ERR_SUCCESS, usb_dfu_init());
+}
+
+void tearDown(void)
+{
+}
+
+/**
+ * @brief Identical image with a page erase before every page: nothing erased
+ */
+void test_identical_image_page_erases(void)
+{
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE, download(image, sizeof(image)));
+    TEST_ASSERT_TRUE(usb_dfu_up_to_date());
+    
+    manifest();
+    
+    TEST_ASSERT_TRUE(usb_dfu_download_complete());
+    TEST_ASSERT_TRUE(usb_dfu_up_to_date());
+    TEST_ASSERT_FALSE(usb_dfu_app_modified());
+    TEST_ASSERT_EQUAL_INT(0, forget_calls);
+    TEST_ASSERT_EQUAL_MEMORY(image, (const void *)APP_BASE, sizeof(image));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, *(const uint8_t *)(APP_BASE + sizeof(image)));
+}
+
+/**
+ * @brief Page erase of the next page, then only the manifestation
+ */
+void test_identical_header_erase_then_manifest(void)
+{
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE, download(image, DFU_XFER_SIZE));
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE,
+                            dfuse_command(DFUSE_CMD_ERASE, APP_BASE + FLASH_PAGE_SIZE));
+    
+    manifest();
+    
+    TEST_ASSERT_TRUE(usb_dfu_download_complete());
+    TEST_ASSERT_FALSE(usb_dfu_app_modified());
+    TEST_ASSERT_EQUAL_MEMORY(image, (const void *)APP_BASE, sizeof(image));
+}
+
+/**
+ * @brief Installed image not verified: the download erases and programs
+ */
+void test_unverified_image_programmed(void)
+{
+    app_verified = false;
+    image[sizeof(image) - 1] ^= 0xFF;
+    
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE, download(image, sizeof(image)));
+    manifest();
+    
+    TEST_ASSERT_TRUE(usb_dfu_download_complete());
+    TEST_ASSERT_FALSE(usb_dfu_up_to_date());
+    TEST_ASSERT_TRUE(usb_dfu_app_modified());
+    TEST_ASSERT_EQUAL_INT(1, forget_calls);
+    TEST_ASSERT_EQUAL_INT(0, kv_reload_calls);
+    TEST_ASSERT_EQUAL_MEMORY(image, (const void *)APP_BASE, sizeof(image));
+}
+
+/**
+ * @brief Identical header, different later block: error, image untouched
+ */
+void test_identical_header_changed_block(void)
+{
+    uint8_t changed[IMAGE_SIZE];
+    
+    memcpy(changed, image, sizeof(changed));
+    changed[FLASH_PAGE_SIZE + 16] ^= 0xFF;
+    
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_ERROR, download(changed, sizeof(changed)));
+    TEST_ASSERT_FALSE(usb_dfu_up_to_date());
+    TEST_ASSERT_FALSE(usb_dfu_app_modified());
+    TEST_ASSERT_EQUAL_MEMORY(image, (const void *)APP_BASE, sizeof(image));
+}
+
+/**
+ * @brief Data partition download: the bootloader's store context is dropped
+ */
+void test_data_download_reloads_kv(void)
+{
+    uint8_t block[64];
+    
+    memset(block, 0x5A, sizeof(block));
+    control(USB_RTYPE_DIR_HOST2DEV | USB_RTYPE_TYPE_STD | USB_RTYPE_RECIPIENT_INTERFACE,
+            USB_REQ_SET_INTERFACE, 1, NULL, 0);
+    
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE, dfuse_command(DFUSE_CMD_ERASE, KV_BASE));
+    TEST_ASSERT_EQUAL_INT(1, kv_reload_calls);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, *(const uint8_t *)KV_BASE);
+    
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE, dfuse_command(DFUSE_CMD_SET_ADDRESS, KV_BASE));
+    TEST_ASSERT_EQUAL_UINT8(DFU_STATE_DFU_DNLOAD_IDLE, dnload(2, block, sizeof(block)));
+    TEST_ASSERT_EQUAL_INT(2, kv_reload_calls);
+    TEST_ASSERT_EQUAL_MEMORY(block, (const void *)KV_BASE, sizeof(block));
+    TEST_ASSERT_EQUAL_MEMORY(image, (const void *)APP_BASE, sizeof(image));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_identical_image_page_erases);
+    RUN_TEST(test_identical_header_erase_then_manifest);
+    RUN_TEST(test_unverified_image_programmed);
+    RUN_TEST(test_identical_header_changed_block);
+    RUN_TEST(test_data_download_reloads_kv);
+    return UNITY_END();
+}
@@ -0,0 +1,125 @@
+#!/usr/bin/env bash
+#
+# MIT License
+# 
+# Copyright (c) 2026 EngEmil
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#
+# Update-then-Boot Cycle Benchmark
+#
+# Downloads an application image with :leave and waits for the device to
+# come back in DFU mode, several times in a row. Meant for the bench_app_fw
+# test firmware, which prints its boot report on the serial port and then
+# re-enters the bootloader via the RAM magic after BENCH_DFU_DELAY_MS.
+#
+# Each run reports the download time (including erase and manifestation),
+# the time until the DFU device is gone (bootloader jumped to the
+# application) and the total cycle time until DFU mode is back. Device
+# detection polls dfu-util, so the boot time resolution is the poll period.
+#
+# Dependencies:
+#   - bash (4.0+)
+#   - dfu-util (0.11+)
+#   - date, stat (coreutils)
+#
+
+set -euo pipefail
+
+APP_ADDRESS="0x08004000"
+POLL_TIMEOUT_MS=10000
+
+die() {
+    echo "Error: $*" >&2
+    exit 1
+}
+
+usage() {
+    echo "Usage: $0 <firmware_signed.bin> [runs]"
+    echo ""
+    echo "Downloads the image 'runs' times (default 3) over DFU alt 0 with"
+    echo ":leave and times each update-then-boot cycle back into DFU mode."
+    exit 1
+}
+
+now_ms() {
+    echo $(( $(date +%s%N) / 1000000 ))
+}
+
+dfu_present() {
+    dfu-util -l 2>/dev/null | grep -q "Found DFU"
+}
+
+# Wait until DFU presence matches $1 (0 = gone, 1 = present)
+wait_dfu() {
+    local want="$1"
+    local deadline=$(( $(now_ms) + POLL_TIMEOUT_MS ))
+    while (( $(now_ms) < deadline )); do
+        if dfu_present; then
+            [ "${want}" -eq 1 ] && return 0
+        else
+            [ "${want}" -eq 0 ] && return 0
+        fi
+    done
+    return 1
+}
+
+main() {
+    if [ $# -lt 1 ] || [ $# -gt 2 ]; then
+        usage
+    fi
+
+    local image="$1"
+    local runs="${2:-3}"
+
+    [ -f "${image}" ] || die "Image '${image}' not found"
+    command -v dfu-util >/dev/null 2>&1 || die "dfu-util not found"
+    dfu_present || die "No DFU device found, enter bootloader mode first"
+
+    local size
+    size=$(stat -c%s "${image}")
+
+    echo "============================================================"
+    echo "Update-then-Boot Cycle Benchmark"
+    echo "============================================================"
+    printf 'Image:            %s (%d bytes)\n' "${image}" "${size}"
+
+    local total_ms=0
+    local i start loaded booted back
+    for (( i = 1; i <= runs; i++ )); do
+        start=$(now_ms)
+        dfu-util -a 0 --dfuse-address "${APP_ADDRESS}:leave" -D "${image}" >/dev/null 2>&1 \
+            || die "dfu-util failed on run ${i}"
+        loaded=$(now_ms)
+        wait_dfu 0 || die "Application did not start on run ${i}"
+        booted=$(now_ms)
+        wait_dfu 1 || die "Bootloader did not come back on run ${i}"
+        back=$(now_ms)
+
+        total_ms=$(( total_ms + back - start ))
+        printf 'Run %d:            download %d ms, boot %d ms, cycle %d ms\n' "${i}" \
+            $(( loaded - start )) $(( booted - loaded )) $(( back - start ))
+    done
+
+    printf 'Average cycle:    %d ms\n' $(( total_ms / runs ))
+    echo "============================================================"
+}
+
+main "$@"
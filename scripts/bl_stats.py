@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+#
+# MIT License
+#
+# Copyright (c) 2026 EngEmil
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""
+Bootloader Diagnostics
+
+Reads diagnostics from the bootloader in DFU mode with USB vendor requests
+(bmRequestType 0xC0, see DFU_VENDOR_REQ_* in bootloader/inc/usb_dfu.h).
+
+Commands:
+  ram      RAM usage and stack high-water marks (DFU_VENDOR_REQ_RAM_STATS)
+  latency  DFU request latency histograms (DFU_VENDOR_REQ_LATENCY),
+           --clear resets them after reading
+  boot     Boot measurements (DFU_VENDOR_REQ_BOOT_STATS): CPU cycles of the
+           last signature check, DFU start-up time
+  status   DFU_GETSTATUS: state, status and status string (iString), e.g.
+           "Already up to date" after the installed image was downloaded
+
+Dependencies:
+  - python3
+  - pyusb (pip install pyusb), libusb
+"""
+
+import argparse
+import struct
+import sys
+
+try:
+    import usb.core
+    import usb.util
+except ImportError:
+    sys.exit("Error: pyusb not found (pip install pyusb)")
+
+DEFAULT_VID = 0x0483
+DEFAULT_PID = 0xDF11
+
+VENDOR_IN = 0xC0  # Device to host, vendor, device
+REQ_RAM_STATS = 0x01
+REQ_LATENCY = 0x02
+REQ_BOOT_STATS = 0x03
+LATENCY_CLEAR = 0x0001
+
+CLASS_IN = 0xA1  # Device to host, class, interface
+DFU_GETSTATUS = 0x03
+DFU_STATES = ["appIDLE", "appDETACH", "dfuIDLE", "dfuDNLOAD-SYNC", "dfuDNBUSY",
+              "dfuDNLOAD-IDLE", "dfuMANIFEST-SYNC", "dfuMANIFEST",
+              "dfuMANIFEST-WAIT-RESET", "dfuUPLOAD-IDLE", "dfuERROR"]
+
+# ram_stats_t (bootloader/inc/ram_stats.h)
+RAM_STATS_VERSION = 1
+RAM_STATS_HEADER = struct.Struct("<HHIIII")
+STACK_NAMES = ["exceptions", "main/process", "idle", "bootloader", "validate"]
+
+# latency_stats_t (bootloader/inc/latency.h)
+LATENCY_VERSION = 1
+LATENCY_BUCKETS = 16
+LATENCY_HIST = struct.Struct("<16HI")
+LATENCY_NAMES = ["DETACH", "DNLOAD", "UPLOAD", "GETSTATUS", "CLRSTATUS",
+                 "GETSTATE", "ABORT", "DNLOAD->program"]
+
+# boot_stats_t (bootloader/inc/bootloader.h)
+BOOT_STATS_VERSION = 2
+BOOT_STATS = struct.Struct("<HHII")
+BOOT_STATS_NONE = 0xFFFFFFFF
+
+
+def vendor_read(dev, request, length, value=0):
+    """Vendor IN request, returns the response bytes"""
+    return bytes(dev.ctrl_transfer(VENDOR_IN, request, value, 0, length))
+
+
+def cmd_ram(dev):
+    data = vendor_read(dev, REQ_RAM_STATS, 64)
+    version, size, ram, data_size, bss, free = RAM_STATS_HEADER.unpack_from(data)
+    if version != RAM_STATS_VERSION or size > len(data):
+        sys.exit(f"Error: unsupported RAM stats version {version} (size {size})")
+
+    offset = RAM_STATS_HEADER.size
+    stacks = []
+    for name in STACK_NAMES:
+        stacks.append((name,) + struct.unpack_from("<HH", data, offset))
+        offset += 4
+    xfer_size, xfer_peak = struct.unpack_from("<HH", data, offset)
+
+    stack_total = sum(s[1] for s in stacks if s[0] in ("exceptions", "main/process"))
+    print(f"RAM (ram0):        {ram} bytes")
+    print(f"  stacks:          {stack_total}")
+    print(f"  .data:           {data_size}")
+    print(f"  .bss:            {bss}")
+    print(f"  other:           {ram - stack_total - data_size - bss - free}")
+    print(f"  unallocated:     {free}")
+    print("")
+    print(f"{'Stack':<16} {'size':>6} {'used':>6} {'free':>6}")
+    for name, stack_size, used in stacks:
+        if stack_size == 0:
+            continue
+        print(f"{name:<16} {stack_size:>6} {used:>6} {stack_size - used:>6}")
+    print("")
+    print(f"DFU buffer:        {xfer_peak} of {xfer_size} bytes used (peak)")
+
+
+def bucket_label(k):
+    """Lower bound of histogram bucket k"""
+    if k == 0:
+        return "<1us"
+    low = 1 << (k - 1)
+    text = f"{low}us" if low < 1000 else f"{low / 1000:g}ms"
+    return (">=" if k == LATENCY_BUCKETS - 1 else "") + text
+
+
+def percentile(counts, fraction):
+    """Bucket holding the given fraction of the samples"""
+    total = sum(counts)
+    running = 0
+    for k, count in enumerate(counts):
+        running += count
+        if running >= total * fraction:
+            return k
+    return LATENCY_BUCKETS - 1
+
+
+def cmd_latency(dev, clear):
+    length = 4 + LATENCY_HIST.size * len(LATENCY_NAMES)
+    data = vendor_read(dev, REQ_LATENCY, length, LATENCY_CLEAR if clear else 0)
+    version, size = struct.unpack_from("<HH", data)
+    if version != LATENCY_VERSION or size > len(data):
+        sys.exit(f"Error: unsupported latency stats version {version} (size {size})")
+
+    print(f"{'Request':<16} {'count':>6} {'p50':>8} {'p99':>8} {'max':>9}")
+    for i, name in enumerate(LATENCY_NAMES):
+        fields = LATENCY_HIST.unpack_from(data, 4 + i * LATENCY_HIST.size)
+        counts, max_us = fields[:LATENCY_BUCKETS], fields[LATENCY_BUCKETS]
+        if sum(counts) == 0:
+            continue
+        print(f"{name:<16} {sum(counts):>6} {bucket_label(percentile(counts, 0.5)):>8} "
+              f"{bucket_label(percentile(counts, 0.99)):>8} {max_us:>7}us")
+        print("    " + " ".join(f"{bucket_label(k)}:{c}" for k, c in enumerate(counts) if c))
+
+
+def cmd_boot(dev):
+    data = vendor_read(dev, REQ_BOOT_STATS, 64)
+    version, size = struct.unpack_from("<HH", data)
+    if version != BOOT_STATS_VERSION or size < BOOT_STATS.size or size > len(data):
+        sys.exit(f"Error: unsupported boot stats version {version} (size {size})")
+    _, _, signature_cycles, dfu_ready_us = BOOT_STATS.unpack_from(data)
+
+    if signature_cycles == BOOT_STATS_NONE:
+        print("Signature check:   not measured")
+    else:
+        print(f"Signature check:   {signature_cycles} cycles")
+    if dfu_ready_us == BOOT_STATS_NONE:
+        print("DFU start-up:      not measured")
+    else:
+        print(f"DFU start-up:      {dfu_ready_us} us")
+
+
+def cmd_status(dev):
+    status, t0, t1, t2, state, istring = dev.ctrl_transfer(CLASS_IN, DFU_GETSTATUS, 0, 0, 6)
+    name = DFU_STATES[state] if state < len(DFU_STATES) else f"state {state}"
+    print(f"State:             {name}")
+    print(f"Status:            {status}")
+    print(f"Poll timeout:      {t0 | (t1 << 8) | (t2 << 16)} ms")
+    if istring:
+        print(f"Status string:     {usb.util.get_string(dev, istring)}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Read bootloader diagnostics over USB")
+    parser.add_argument("command", choices=["ram", "latency", "boot", "status"])
+    parser.add_argument("--clear", action="store_true", help="clear latency histograms after reading")
+    parser.add_argument("--vid", type=lambda x: int(x, 0), default=DEFAULT_VID)
+    parser.add_argument("--pid", type=lambda x: int(x, 0), default=DEFAULT_PID)
+    args = parser.parse_args()
+
+    dev = usb.core.find(idVendor=args.vid, idProduct=args.pid)
+    if dev is None:
+        sys.exit(f"Error: no device {args.vid:04x}:{args.pid:04x} (bootloader in DFU mode?)")
+
+    if args.command == "ram":
+        cmd_ram(dev)
+    elif args.command == "latency":
+        cmd_latency(dev, args.clear)
+    elif args.command == "boot":
+        cmd_boot(dev)
+    elif args.command == "status":
+        cmd_status(dev)
+
+
+if __name__ == "__main__":
+    main()
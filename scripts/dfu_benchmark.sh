@@ -0,0 +1,97 @@
+#!/usr/bin/env bash
+#
+# MIT License
+# 
+# Copyright (c) 2026 EngEmil
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#
+# DFU Download Throughput Benchmark
+#
+# Downloads an application image to the bootloader (DFU alt 0) several times
+# and reports the time and throughput of each run, including erase and
+# manifestation. Used to compare bootloader builds (e.g. RT and NIL kernel).
+#
+# The board must be in bootloader mode. The image is not started (no
+# :leave), so the runs can follow each other.
+#
+# Dependencies:
+#   - bash (4.0+)
+#   - dfu-util (0.11+)
+#   - date, stat (coreutils)
+#   - awk
+#
+
+set -euo pipefail
+
+APP_ADDRESS="0x08004000"
+
+die() {
+    echo "Error: $*" >&2
+    exit 1
+}
+
+usage() {
+    echo "Usage: $0 <firmware_signed.bin> [runs]"
+    echo ""
+    echo "Downloads the image 'runs' times (default 3) over DFU alt 0 and"
+    echo "prints the download time and throughput of each run."
+    exit 1
+}
+
+main() {
+    if [ $# -lt 1 ] || [ $# -gt 2 ]; then
+        usage
+    fi
+
+    local image="$1"
+    local runs="${2:-3}"
+
+    [ -f "${image}" ] || die "Image '${image}' not found"
+    command -v dfu-util >/dev/null 2>&1 || die "dfu-util not found"
+
+    local size
+    size=$(stat -c%s "${image}")
+
+    echo "============================================================"
+    echo "DFU Download Benchmark"
+    echo "============================================================"
+    printf 'Image:            %s (%d bytes)\n' "${image}" "${size}"
+
+    local total_ms=0
+    local i start end ms
+    for (( i = 1; i <= runs; i++ )); do
+        start=$(date +%s%N)
+        dfu-util -a 0 --dfuse-address "${APP_ADDRESS}" -D "${image}" >/dev/null 2>&1 \
+            || die "dfu-util failed on run ${i}"
+        end=$(date +%s%N)
+
+        ms=$(( (end - start) / 1000000 ))
+        total_ms=$(( total_ms + ms ))
+        printf 'Run %d:            %d ms (%s KB/s)\n' "${i}" "${ms}" \
+            "$(awk "BEGIN {printf \"%.1f\", ${size} / 1024 / (${ms} / 1000)}")"
+    done
+
+    printf 'Average:          %d ms (%s KB/s)\n' $(( total_ms / runs )) \
+        "$(awk "BEGIN {printf \"%.1f\", ${size} * ${runs} / 1024 / (${total_ms} / 1000)}")"
+    echo "============================================================"
+}
+
+main "$@"
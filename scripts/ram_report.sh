@@ -0,0 +1,133 @@
+#!/usr/bin/env bash
+#
+# MIT License
+# 
+# Copyright (c) 2026 EngEmil
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#
+# Bootloader RAM Report
+#
+# Static RAM map of the bootloader ELF broken down by source module (.data
+# and .bss symbols, located with the debug line info, so LTO builds are
+# covered), plus the stacks from the linker script. Warns when the RAM not
+# allocated at build time drops below the headroom threshold.
+#
+# Runs after every bootloader build (make target ram-report). Stack
+# high-water marks and transfer buffer peaks are runtime values, read from
+# the device with scripts/bl_stats.py.
+#
+# Dependencies:
+#   - bash (4.0+)
+#   - arm-none-eabi-nm (binutils, NM to override)
+#   - awk, sort
+#
+
+set -euo pipefail
+
+NM="${NM:-arm-none-eabi-nm}"
+
+die() {
+    echo "Error: $*" >&2
+    exit 1
+}
+
+usage() {
+    echo "Usage: $0 <bootloader.elf> [headroom_min]"
+    echo ""
+    echo "Prints RAM usage per module and warns when less than 'headroom_min'"
+    echo "bytes (default 2048) of RAM are left unallocated."
+    exit 1
+}
+
+# Value of a linker script symbol (decimal)
+symbol() {
+    local value
+    value=$("${NM}" "$1" | awk -v s="$2" '$3 == s {print $1; exit}')
+    [ -n "${value}" ] || die "Symbol '$2' not found in $1"
+    echo $(( 16#${value} ))
+}
+
+main() {
+    if [ $# -lt 1 ] || [ $# -gt 2 ]; then
+        usage
+    fi
+
+    local elf="$1"
+    local headroom_min="${2:-2048}"
+
+    [ -f "${elf}" ] || die "ELF '${elf}' not found"
+    command -v "${NM}" >/dev/null 2>&1 || die "${NM} not found"
+
+    local mstack pstack data bss heap_base heap_end free
+    mstack=$(( $(symbol "${elf}" __main_stack_end__) - $(symbol "${elf}" __main_stack_base__) ))
+    pstack=$(( $(symbol "${elf}" __process_stack_end__) - $(symbol "${elf}" __process_stack_base__) ))
+    data=$(( $(symbol "${elf}" __data_end__) - $(symbol "${elf}" __data_base__) ))
+    bss=$(( $(symbol "${elf}" __bss_end__) - $(symbol "${elf}" __bss_base__) ))
+    heap_base=$(symbol "${elf}" __heap_base__)
+    heap_end=$(symbol "${elf}" __heap_end__)
+    free=$(( heap_end - heap_base ))
+
+    echo "============================================================"
+    echo "Bootloader RAM Report: ${elf}"
+    echo "============================================================"
+    printf '%-24s %8s %8s\n' "Module" ".data" ".bss"
+
+    # Sized data/bss symbols grouped by source file (symbols without
+    # debug info are kernel/HAL library code or linker generated)
+    "${NM}" -S -l "${elf}" | awk -F'\t' '
+        function hex(s,    i, v) {
+            v = 0
+            for (i = 1; i <= length(s); i++) {
+                v = v * 16 + index("0123456789abcdef", tolower(substr(s, i, 1))) - 1
+            }
+            return v
+        }
+        {
+            split($1, f, " ")
+            if (f[2] == "" || f[3] !~ /^[bBdD]$/) next
+            module = "(no debug info)"
+            if ($2 != "") {
+                module = $2
+                sub(/:[0-9]+$/, "", module)
+                sub(/.*\//, "", module)
+            }
+            size = hex(f[2])
+            if (f[3] ~ /[dD]/) d[module] += size; else b[module] += size
+            seen[module] = 1
+        }
+        END {
+            for (m in seen) printf "%-24s %8d %8d\n", m, d[m], b[m]
+        }' | sort -k3,3nr -k2,2nr
+
+    echo "------------------------------------------------------------"
+    printf '%-24s %8d\n' "Exception stack" "${mstack}"
+    printf '%-24s %8d\n' "Process stack" "${pstack}"
+    printf '%-24s %8d\n' ".data total" "${data}"
+    printf '%-24s %8d  (thread working areas included)\n' ".bss total" "${bss}"
+    printf '%-24s %8d\n' "Unallocated" "${free}"
+    echo "============================================================"
+
+    if [ "${free}" -lt "${headroom_min}" ]; then
+        echo "WARNING: RAM headroom ${free} bytes is below ${headroom_min} bytes" >&2
+    fi
+}
+
+main "$@"
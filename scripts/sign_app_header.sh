@@ -31,7 +31,7 @@
 # - Version (4 bytes)
 # - Firmware size (4 bytes, signed at offset 8)
 # - CRC32 checksum (4 bytes, signed at offset 12)
-# - Reserved (16 bytes)
+# - USB VID/PID, flags and header version fields (16 bytes)
 # 
 #
 # This script:
@@ -39,7 +39,13 @@
 # 2. Calculates the firmware size (from vector table to end)
 # 3. Calculates CRC32 of the firmware (from vector table to end)
 # 4. Signs the header with the size and CRC32 at offset 8 and 12
-# 5. Writes the signed binary
+# 5. For header version 2: adds the SHA-256 of the firmware as TLV entry,
+#    walks the TLV area after the header and signs header_size and
+#    header_crc (CRC32 of the TLV area) at offset 26 and 28
+# 6. With a signing key (third argument or APP_SIGNING_KEY): adds an Ed25519
+#    signature of the SHA-256 digest as TLV entry, before step 5 signs the
+#    TLV area
+# 7. Writes the signed binary
 #
 # Dependencies:
 #   - bash (4.0+)
@@ -50,18 +56,33 @@
 #   - gzip     (gzip)
 #   - tail     (coreutils)
 #   - mktemp   (coreutils)
+#   - sha256sum (coreutils)
+#   - openssl  (3.0+, only with a signing key)
 #
 # All dependencies are standard on any Linux distribution (including
 # minimal/embedded environments and Docker containers). No additional
 # packages are required beyond the base coreutils and gzip.
 #
+# Signing key (Ed25519, PEM):
+#   openssl genpkey -algorithm ed25519 -out signing_key.pem
+#
 # Application header structure (32 bytes at offset 0):
 #   Offset 0:  magic (0xDEADBEEF) - 4 bytes (little-endian)
 #   Offset 4:  version            - 4 bytes (little-endian)
 #   Offset 8:  size               - 4 bytes (little-endian, SIGNED)
 #   Offset 12: crc32              - 4 bytes (little-endian, SIGNED)
-#   Offset 16: reserved[4]        - 16 bytes
+#   Offset 16: usb_vid/usb_pid    - 4 bytes
+#   Offset 20: flags              - 4 bytes
+#   Offset 24: header_version     - 2 bytes (0 = version 1)
+#   Offset 26: header_size        - 2 bytes (little-endian, SIGNED, version 2)
+#   Offset 28: header_crc         - 4 bytes (little-endian, SIGNED, version 2)
 #
+# Header version 2 TLV area (offset 32 up to header_size, max 0x100):
+#   Entries of {type (1 byte), len (1 byte), value (len bytes)}, unaligned.
+#   Type 0x00 or 0xFF ends the list.
+#   Type 0x02 (SHA-256 of firmware from offset 0x100 to end) is added here.
+#   Type 0x03 (Ed25519 signature of the type 0x02 digest) is added here when
+#   a signing key is given.
 # IMPORTANT: CRC is calculated over firmware starting at offset 0x100
 # (vector table), NOT from offset 0x20 (after header).
 
@@ -70,6 +91,9 @@ set -euo pipefail
 HEADER_SIZE=32
 VECTOR_TABLE_OFFSET=256  # 0x100
 MAGIC="DEADBEEF"
+HEADER_VERSION_TLV=2     # First header version with TLV area
+TLV_SHA256=2             # APP_TLV_SHA256 (32-byte digest)
+TLV_SIGNATURE=3          # APP_TLV_SIGNATURE (64-byte Ed25519 signature)
 
 # --- Helper functions ---
 
@@ -114,6 +138,41 @@ read_le32() {
     printf '%d' "0x${hex}"
 }
 
+# Read an 8-bit unsigned integer from a file at a given offset.
+# Usage: read_u8 <file> <byte_offset>
+# Outputs the value as a decimal integer.
+read_u8() {
+    local byte
+    byte=$(od -An -tu1 -N1 -j"$2" "$1" | tr -d ' \n')
+
+    if [ -z "${byte}" ]; then
+        die "Failed to read byte at offset $2 from $1"
+    fi
+
+    echo "${byte}"
+}
+
+# Read a 16-bit little-endian unsigned integer from a file at a given offset.
+# Usage: read_le16 <file> <byte_offset>
+# Outputs the value as a decimal integer.
+read_le16() {
+    local lo hi
+    lo=$(read_u8 "$1" "$2")
+    hi=$(read_u8 "$1" $(( $2 + 1 )))
+    echo $(( lo | (hi << 8) ))
+}
+
+# Write a 16-bit little-endian unsigned integer to a file at a given offset.
+# Usage: write_le16 <file> <byte_offset> <value>
+write_le16() {
+    local file="$1"
+    local offset="$2"
+    local value="$3"
+
+    printf "\\x$(printf '%02x' $(( value & 0xFF )))\\x$(printf '%02x' $(( (value >> 8) & 0xFF )))" \
+        | dd of="${file}" bs=1 seek="${offset}" conv=notrunc status=none
+}
+
 # Write a 32-bit little-endian unsigned integer to a file at a given offset.
 # Usage: write_le32 <file> <byte_offset> <value>
 write_le32() {
@@ -157,14 +216,148 @@ calculate_crc32() {
     printf '%d' "0x${hex_crc}"
 }
 
+# Calculate CRC32 of a byte range of a file.
+# Usage: calculate_crc32_range <file> <byte_offset> <length>
+# Outputs the CRC32 as a decimal integer (0 for an empty range).
+calculate_crc32_range() {
+    local file="$1"
+    local offset="$2"
+    local length="$3"
+    local hex_crc
+
+    hex_crc=$(dd if="${file}" bs=1 skip="${offset}" count="${length}" status=none \
+        | gzip -c \
+        | tail -c 8 \
+        | od -An -tx4 -N4 \
+        | tr -d ' \n')
+
+    if [ -z "${hex_crc}" ]; then
+        die "Failed to calculate CRC32"
+    fi
+
+    printf '%d' "0x${hex_crc}"
+}
+
+# Find the end of the TLV area (header version 2).
+# Usage: tlv_area_end <file>
+# Outputs the offset after the last TLV entry (header_size).
+tlv_area_end() {
+    local file="$1"
+    local offset=${HEADER_SIZE}
+    local type len
+
+    while [ $(( offset + 2 )) -le ${VECTOR_TABLE_OFFSET} ]; do
+        type=$(read_u8 "${file}" "${offset}")
+        if [ "${type}" -eq 0 ] || [ "${type}" -eq 255 ]; then
+            break
+        fi
+        len=$(read_u8 "${file}" $(( offset + 1 )))
+        if [ $(( offset + 2 + len )) -gt ${VECTOR_TABLE_OFFSET} ]; then
+            die "TLV type 0x$(printf '%02X' "${type}") at offset ${offset} overruns the header area"
+        fi
+        offset=$(( offset + 2 + len ))
+    done
+
+    echo "${offset}"
+}
+
+# Find a TLV entry by type (header version 2).
+# Usage: tlv_find <file> <type>
+# Outputs the offset of the entry, or nothing if not present.
+tlv_find() {
+    local file="$1"
+    local wanted="$2"
+    local offset=${HEADER_SIZE}
+    local type len
+
+    while [ $(( offset + 2 )) -le ${VECTOR_TABLE_OFFSET} ]; do
+        type=$(read_u8 "${file}" "${offset}")
+        if [ "${type}" -eq 0 ] || [ "${type}" -eq 255 ]; then
+            return
+        fi
+        if [ "${type}" -eq "${wanted}" ]; then
+            echo "${offset}"
+            return
+        fi
+        len=$(read_u8 "${file}" $(( offset + 1 )))
+        offset=$(( offset + 2 + len ))
+    done
+}
+
+# Write a hex string as bytes to a file at a given offset.
+# Usage: write_hex <file> <byte_offset> <hex_string>
+write_hex() {
+    local file="$1"
+    local offset="$2"
+    local hex="$3"
+    local escaped=""
+    local i
+
+    for (( i = 0; i < ${#hex}; i += 2 )); do
+        escaped+="\\x${hex:i:2}"
+    done
+
+    printf "${escaped}" | dd of="${file}" bs=1 seek="${offset}" conv=notrunc status=none
+}
+
+# Add or replace a TLV entry (header version 2).
+# Usage: write_tlv <file> <type> <hex_value>
+write_tlv() {
+    local file="$1"
+    local type="$2"
+    local hex="$3"
+    local len=$(( ${#hex} / 2 ))
+    local offset
+
+    offset=$(tlv_find "${file}" "${type}")
+    if [ -n "${offset}" ]; then
+        if [ "$(read_u8 "${file}" $(( offset + 1 )))" -ne "${len}" ]; then
+            die "TLV type 0x$(printf '%02X' "${type}") has unexpected length"
+        fi
+    else
+        offset=$(tlv_area_end "${file}")
+        if [ $(( offset + 2 + len )) -gt ${VECTOR_TABLE_OFFSET} ]; then
+            die "No room for TLV type 0x$(printf '%02X' "${type}") in header area"
+        fi
+        write_hex "${file}" "${offset}" "$(printf '%02x%02x' "${type}" "${len}")"
+    fi
+
+    write_hex "${file}" $(( offset + 2 )) "${hex}"
+}
+
+# Sign a SHA-256 digest with an Ed25519 private key.
+# Usage: sign_digest <key.pem> <hex_digest>
+# Outputs the 64-byte signature as a hex string.
+sign_digest() {
+    local key="$1"
+    local digest="$2"
+    local tmp signature
+
+    command -v openssl >/dev/null 2>&1 || die "openssl is required for signing"
+
+    tmp=$(mktemp)
+    write_hex "${tmp}" 0 "${digest}"
+    signature=$(openssl pkeyutl -sign -inkey "${key}" -rawin -in "${tmp}" \
+        | od -An -tx1 -v | tr -d ' \n') || true
+    rm -f "${tmp}"
+
+    if [ ${#signature} -ne 128 ]; then
+        die "Failed to sign digest with '${key}' (Ed25519 key required)"
+    fi
+
+    echo "${signature}"
+}
+
 # --- Main ---
 
 usage() {
-    echo "Usage: $0 <input.bin> <output.bin>"
+    echo "Usage: $0 <input.bin> <output.bin> [signing_key.pem]"
     echo ""
     echo "This script signs the application header with:"
     echo "  - Firmware size (bytes from offset 0x100 to end)"
     echo "  - CRC32 checksum (of firmware from offset 0x100 to end)"
+    echo "  - Ed25519 signature of the SHA-256 digest (header version 2, with"
+    echo "    signing key argument or APP_SIGNING_KEY environment variable)"
     echo ""
     echo "Note: CRC excludes header (32 bytes) and padding (224 bytes)."
     echo "The signed binary can then be uploaded via DFU."
@@ -172,12 +365,17 @@ usage() {
 }
 
 main() {
-    if [ $# -ne 2 ]; then
+    if [ $# -lt 2 ] || [ $# -gt 3 ]; then
         usage
     fi
 
     local input_file="$1"
     local output_file="$2"
+    local signing_key="${3:-${APP_SIGNING_KEY:-}}"
+
+    if [ -n "${signing_key}" ] && [ ! -f "${signing_key}" ]; then
+        die "Signing key '${signing_key}' not found"
+    fi
 
     # Check input file exists
     if [ ! -f "${input_file}" ]; then
@@ -218,6 +416,32 @@ main() {
     write_le32 "${output_file}" 8 "${firmware_size}"
     write_le32 "${output_file}" 12 "${crc32}"
 
+    # Header version 2: add image digest, sign TLV area size and CRC32
+    local header_version header_size header_crc sha256 signature
+    header_version=$(read_le16 "${input_file}" 24)
+    header_size=${HEADER_SIZE}
+    header_crc=0
+    sha256=""
+    signature=""
+    if [ -n "${signing_key}" ] && [ "${header_version}" -lt ${HEADER_VERSION_TLV} ]; then
+        die "Signing requires header version ${HEADER_VERSION_TLV}"
+    fi
+    if [ "${header_version}" -ge ${HEADER_VERSION_TLV} ]; then
+        sha256=$(dd if="${input_file}" bs=1 skip="${VECTOR_TABLE_OFFSET}" status=none \
+            | sha256sum | cut -d' ' -f1)
+        write_tlv "${output_file}" ${TLV_SHA256} "${sha256}"
+
+        if [ -n "${signing_key}" ]; then
+            signature=$(sign_digest "${signing_key}" "${sha256}")
+            write_tlv "${output_file}" ${TLV_SIGNATURE} "${signature}"
+        fi
+
+        header_size=$(tlv_area_end "${output_file}")
+        header_crc=$(calculate_crc32_range "${output_file}" "${HEADER_SIZE}" $(( header_size - HEADER_SIZE )))
+        write_le16 "${output_file}" 26 "${header_size}"
+        write_le32 "${output_file}" 28 "${header_crc}"
+    fi
+
     # Calculate total output size (should be same as input)
     local total_size
     total_size=$(stat -c%s "${output_file}")
@@ -247,6 +471,16 @@ main() {
     printf 'Magic:            0x%s\n' "${magic_hex}"
     printf 'Version:          0x%08X (%d.%d.%d)\n' "${version}" "${ver_major}" "${ver_minor}" "${ver_patch}"
     printf 'CRC32:            0x%08X\n' "${crc32}"
+    if [ "${header_version}" -ge ${HEADER_VERSION_TLV} ]; then
+        printf 'Header version:   %d (TLV area %d bytes, CRC32 0x%08X)\n' \
+            "${header_version}" $(( header_size - HEADER_SIZE )) "${header_crc}"
+        printf 'SHA-256:          %s\n' "${sha256}"
+        if [ -n "${signature}" ]; then
+            printf 'Signature:        Ed25519 (%s)\n' "${signing_key}"
+        fi
+    else
+        printf 'Header version:   1\n'
+    fi
     echo "============================================================"
 
     return 0
@@ -0,0 +1,88 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef APP_HEADER_H
+#define APP_HEADER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Application header structure
+ * 
+ * This header must be placed at the start of the application (0x08004000)
+ * to enable firmware validation by the bootloader.
+ * 
+ * The usb_vid and usb_pid fields allow the application to specify USB
+ * identifiers that the bootloader will use in DFU mode.
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t magic;          /* Magic number: 0xDEADBEEF */
+    uint32_t version;        /* Firmware version */
+    uint32_t size;           /* Firmware size in bytes (excluding header) */
+    uint32_t crc32;          /* CRC32 of firmware (excluding this header) */
+    uint16_t usb_vid;        /* USB Vendor ID for bootloader DFU mode */
+    uint16_t usb_pid;        /* USB Product ID for bootloader DFU mode */
+    uint32_t flags;          /* Application flags (APP_FLAG_*) */
+    uint16_t header_version; /* Header version (APP_HEADER_VERSION) */
+    uint16_t header_size;    /* Header size including TLV area (signed by build script) */
+    uint32_t header_crc;     /* CRC32 of TLV area (signed by build script) */
+} app_header_t;
+
+/**
+ * @brief TLV extension entry with 32-bit value
+ * 
+ * Placed in the .app_header_tlv section, directly after the header.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;            /* APP_TLV_* */
+    uint8_t len;             /* Value length (4) */
+    uint32_t value;          /* Little-endian value */
+} app_tlv_u32_t;
+
+#define APP_HEADER_MAGIC    0xDEADBEEF
+#define APP_VERSION         0x00010000  /* Version 1.0.0 */
+
+/* USB VID/PID - customize these or use defaults (STMicroelectronics DFU) */
+#ifndef USB_VID
+#define USB_VID             0x0483      /* STMicroelectronics */
+#endif
+#ifndef USB_PID
+#define USB_PID             0xDF11      /* DFU mode */
+#endif
+
+/* Application flags - bootloader behavior options */
+#define APP_FLAG_WARM_HANDOFF   (1U << 0)  /* Keep bootloader clock configuration at jump */
+/* Header version 2: TLV extension area after the 32-byte header */
+#define APP_HEADER_VERSION      2
+#define APP_TLV_MIN_BL_VERSION  0x01       /* Minimum bootloader version (uint32_t) */
+
+/* Define to refuse booting on older bootloaders, e.g. 0x00020000 for v2.0.0
+ * (first version reading TLVs, earlier ones ignore this entry) */
+//#define APP_MIN_BL_VERSION    0x00020000
+
+#ifndef APP_FLAGS
+#define APP_FLAGS           0           /* Reset-default clocks at jump */
+#endif
+
+#endif /* APP_HEADER_H */
@@ -0,0 +1,250 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/*
+ * Bootloader Benchmark Test Application
+ *
+ * Measures the bootloader from the application side:
+ * - Handoff state captured before the C runtime and ChibiOS touch it
+ *   (time spent in the bootloader, clock configuration, VTOR, MSP and
+ *   reset cause)
+ * - Flash read bandwidth and CRC32 throughput (bootloader service table)
+ *   from application context
+ * - Re-entry into DFU mode via the RAM magic, so a host loop can time
+ *   complete update-then-boot cycles
+ *
+ * The report is printed on USART2 (ST-LINK virtual COM port).
+ */
+
+#include <stdint.h>
+
+#include "ch.h"
+#include "hal.h"
+#include "chprintf.h"
+#include "app_header.h"
+#include "bootloader_services.h"
+
+#define BOOTLOADER_MAGIC_ADDR   ((volatile uint32_t *)0x20005FFC)
+#define BOOTLOADER_MAGIC        0xDEADBEEF
+
+#define APP_BASE                0x08004000U
+#define APP_VECTORS_ADDR        (APP_BASE + 0x100U)
+
+/* Bootloader system tick (TIM16), see bootloader/inc/chconf.h */
+#define BL_ST_FREQUENCY         10000U
+
+/* HSISYS before the HSIDIV divider */
+#define HSI48_FREQUENCY         48000000U
+
+#ifndef BENCH_FLASH_BYTES
+#define BENCH_FLASH_BYTES       (16U * 1024U)   /* Flash read benchmark length */
+#endif
+
+#ifndef BENCH_CRC_BYTES
+#define BENCH_CRC_BYTES         (16U * 1024U)   /* CRC32 benchmark length */
+#endif
+
+#ifndef BENCH_RUNS
+#define BENCH_RUNS              4U              /* Best of N runs is reported */
+#endif
+
+#ifndef BENCH_DFU_DELAY_MS
+#define BENCH_DFU_DELAY_MS      1000U           /* 0 = wait for the user button */
+#endif
+
+/* Handoff state, filled in by __core_init() before .data/.bss init */
+typedef struct {
+    uint32_t bl_ticks;      /* TIM16->CNT, bootloader ticks since its chSysInit() */
+    uint32_t rcc_cr;
+    uint32_t rcc_cfgr;
+    uint32_t rcc_csr2;      /* Reset flags */
+    uint32_t flash_acr;
+    uint32_t vtor;
+    uint32_t msp;
+} handoff_t;
+
+/* Placed in the no-init part of RAM0, so crt0 does not clear it */
+__attribute__((section(".ram0")))
+static handoff_t handoff;
+
+static const SerialConfig serial_cfg = {
+    115200,
+    0,
+    USART_CR2_STOP1_BITS,
+    0
+};
+
+/**
+ * @brief Early core initialization hook (called by crt0)
+ *
+ * Runs right after reset, before the clock setup and RAM initialization of
+ * the application, so the registers still hold what the bootloader left.
+ */
+void __core_init(void) {
+    handoff.bl_ticks = TIM16->CNT;
+    handoff.rcc_cr = RCC->CR;
+    handoff.rcc_cfgr = RCC->CFGR;
+    handoff.rcc_csr2 = RCC->CSR2;
+    handoff.flash_acr = FLASH->ACR;
+    handoff.vtor = SCB->VTOR;
+    handoff.msp = __get_MSP();
+
+    /* Clear the reset flags so the next boot reports its own cause */
+    RCC->CSR2 |= RCC_CSR2_RMVF;
+}
+
+/* SysTick is not used by ChibiOS here (ST is TIM16), so it counts cycles */
+static void cycles_start(void) {
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+}
+
+static uint32_t cycles_stop(void) {
+    uint32_t elapsed = SysTick_LOAD_RELOAD_Msk - SysTick->VAL;
+    SysTick->CTRL = 0;
+    return elapsed;
+}
+
+static uint32_t bench_flash_read(void) {
+    const volatile uint32_t *p = (const volatile uint32_t *)APP_BASE;
+    uint32_t acc = 0;
+
+    chSysLock();
+    cycles_start();
+    for (uint32_t i = 0; i < BENCH_FLASH_BYTES / 4U; i += 4U) {
+        acc += p[i] + p[i + 1U] + p[i + 2U] + p[i + 3U];
+    }
+    uint32_t cycles = cycles_stop();
+    chSysUnlock();
+
+    (void)acc;
+    return cycles;
+}
+
+static uint32_t bench_crc(const bl_services_t *bl, uint32_t *crc) {
+    chSysLock();
+    cycles_start();
+    uint32_t c = bl->crc32_init();
+    c = bl->crc32_update(c, (const uint8_t *)APP_BASE, BENCH_CRC_BYTES);
+    c = bl->crc32_finalize(c);
+    uint32_t cycles = cycles_stop();
+    chSysUnlock();
+
+    *crc = c;
+    return cycles;
+}
+
+static void print_rate(BaseSequentialStream *out, const char *name, uint32_t bytes, uint32_t cycles) {
+    uint32_t kbps = (uint32_t)(((uint64_t)bytes * STM32_SYSCLK) / ((uint64_t)cycles * 1024U));
+    uint32_t cpb = (uint32_t)(((uint64_t)cycles * 100U) / bytes);
+
+    chprintf(out, "%-10s%u B in %u cycles, %u KB/s (%u.%02u cycles/B)\r\n",
+             name, bytes, cycles, kbps, cpb / 100U, cpb % 100U);
+}
+
+static void print_handoff(BaseSequentialStream *out) {
+    const uint32_t *vectors = (const uint32_t *)APP_VECTORS_ADDR;
+    uint32_t bl_us = (uint32_t)(((uint64_t)handoff.bl_ticks * 1000000U) / BL_ST_FREQUENCY);
+    uint32_t hsidiv = (handoff.rcc_cr & RCC_CR_HSIDIV) >> RCC_CR_HSIDIV_Pos;
+    uint32_t sws = (handoff.rcc_cfgr & RCC_CFGR_SWS) >> RCC_CFGR_SWS_Pos;
+
+    chprintf(out, "Boot:     %u.%03u ms in bootloader (%u ticks at %u Hz)\r\n",
+             bl_us / 1000U, bl_us % 1000U, handoff.bl_ticks, BL_ST_FREQUENCY);
+    chprintf(out, "Reset:    CSR2 0x%08x%s%s%s%s\r\n", handoff.rcc_csr2,
+             (handoff.rcc_csr2 & RCC_CSR2_PINRSTF) ? " PIN" : "",
+             (handoff.rcc_csr2 & RCC_CSR2_SFTRSTF) ? " SOFTWARE" : "",
+             (handoff.rcc_csr2 & RCC_CSR2_PWRRSTF) ? " POWER" : "",
+             (handoff.rcc_csr2 & RCC_CSR2_IWDGRSTF) ? " IWDG" : "");
+    if (sws == 0U) {
+        chprintf(out, "Clock:    handoff SYSCLK %u Hz (HSISYS, HSIDIV /%u), CFGR 0x%08x\r\n",
+                 HSI48_FREQUENCY >> hsidiv, 1U << hsidiv, handoff.rcc_cfgr);
+    } else {
+        chprintf(out, "Clock:    handoff SW source %u, CFGR 0x%08x\r\n", sws, handoff.rcc_cfgr);
+    }
+    chprintf(out, "Flash:    handoff ACR 0x%08x (latency %u), app ACR 0x%08x\r\n",
+             handoff.flash_acr, handoff.flash_acr & FLASH_ACR_LATENCY, FLASH->ACR);
+    chprintf(out, "VTOR:     0x%08x (expected 0x%08x) %s\r\n",
+             handoff.vtor, APP_VECTORS_ADDR,
+             handoff.vtor == APP_VECTORS_ADDR ? "OK" : "MISMATCH");
+    chprintf(out, "MSP:      0x%08x (vector[0] 0x%08x) %s\r\n",
+             handoff.msp, vectors[0],
+             handoff.msp == vectors[0] ? "OK" : "MISMATCH");
+}
+
+static void enter_bootloader(void) {
+    chSysDisable();
+    *BOOTLOADER_MAGIC_ADDR = BOOTLOADER_MAGIC;
+    NVIC_SystemReset();
+}
+
+int main(void) {
+    halInit();
+    chSysInit();
+    sdStart(&SD2, &serial_cfg);
+
+    BaseSequentialStream *out = (BaseSequentialStream *)&SD2;
+    const bl_services_t *bl = bl_services_get();
+
+    chprintf(out, "\r\n=== bench-app-fw (SYSCLK %u Hz) ===\r\n", STM32_SYSCLK);
+    print_handoff(out);
+
+    uint32_t best = UINT32_MAX;
+    for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+        uint32_t cycles = bench_flash_read();
+        if (cycles < best) {
+            best = cycles;
+        }
+    }
+    print_rate(out, "Read:", BENCH_FLASH_BYTES, best);
+
+    if (bl != NULL) {
+        uint32_t crc = 0;
+        best = UINT32_MAX;
+        for (uint32_t run = 0; run < BENCH_RUNS; run++) {
+            uint32_t cycles = bench_crc(bl, &crc);
+            if (cycles < best) {
+                best = cycles;
+            }
+        }
+        print_rate(out, "CRC32:", BENCH_CRC_BYTES, best);
+        chprintf(out, "          crc 0x%08x, bootloader 0x%08x\r\n", crc, bl->get_version());
+    } else {
+        chprintf(out, "CRC32:    skipped, no bootloader service table\r\n");
+    }
+
+#if BENCH_DFU_DELAY_MS > 0
+    chprintf(out, "DFU:      re-entering bootloader in %u ms\r\n", BENCH_DFU_DELAY_MS);
+    chThdSleepMilliseconds(BENCH_DFU_DELAY_MS);
+#else
+    chprintf(out, "DFU:      press the user button to re-enter the bootloader\r\n");
+    while (palReadLine(LINE_BUTTON) != PAL_LOW) {
+        palToggleLine(LINE_LED_GREEN);
+        chThdSleepMilliseconds(100);
+    }
+#endif
+
+    enter_bootloader();
+    return 0;
+}
@@ -43,9 +43,23 @@ typedef struct __attribute__((packed)) {
     uint32_t crc32;          /* CRC32 checksum (excluding this header) */
     uint16_t usb_vid;        /* USB Vendor ID for bootloader DFU mode */
     uint16_t usb_pid;        /* USB Product ID for bootloader DFU mode */
-    uint32_t reserved[3];    /* Reserved for future use */
+    uint32_t flags;          /* Application flags (APP_FLAG_*) */
+    uint16_t header_version; /* Header version (APP_HEADER_VERSION) */
+    uint16_t header_size;    /* Header size including TLV area (signed by build script) */
+    uint32_t header_crc;     /* CRC32 of TLV area (signed by build script) */
 } app_header_t;
 
+/**
+ * @brief TLV extension entry with 32-bit value
+ * 
+ * Placed in the .app_header_tlv section, directly after the header.
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;            /* APP_TLV_* */
+    uint8_t len;             /* Value length (4) */
+    uint32_t value;          /* Little-endian value */
+} app_tlv_u32_t;
+
 /* Constants - customize these for your application */
 #define APP_HEADER_MAGIC    0xDEADBEEF
 #define APP_VERSION         0x00000000  /* Version 0.0.0 */
@@ -58,4 +72,18 @@ typedef struct __attribute__((packed)) {
 #define USB_PID             0xDF11      /* DFU mode */
 #endif
 
+/* Application flags - bootloader behavior options */
+#define APP_FLAG_WARM_HANDOFF   (1U << 0)  /* Keep bootloader clock configuration at jump */
+/* Header version 2: TLV extension area after the 32-byte header */
+#define APP_HEADER_VERSION      2
+#define APP_TLV_MIN_BL_VERSION  0x01       /* Minimum bootloader version (uint32_t) */
+
+/* Define to refuse booting on older bootloaders, e.g. 0x00020000 for v2.0.0
+ * (first version reading TLVs, earlier ones ignore this entry) */
+//#define APP_MIN_BL_VERSION    0x00020000
+
+#ifndef APP_FLAGS
+#define APP_FLAGS           0           /* Reset-default clocks at jump */
+#endif
+
 #endif /* APP_HEADER_H */
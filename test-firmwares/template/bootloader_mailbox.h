@@ -0,0 +1,173 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef BOOTLOADER_MAILBOX_H
+#define BOOTLOADER_MAILBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief Boot mailbox client (application side)
+ * 
+ * CRC-guarded request structure at the top of RAM, read by the bootloader
+ * on the next reset. Replaces writing BOOTLOADER_MAGIC to 0x20005FFC (which
+ * still works) with specific requests, and reports the boot counter and
+ * how the application was started.
+ * 
+ * The application linker script must keep the top 32 bytes of RAM free
+ * (ram0 len = 24k - 32, see template/STM32C071xB_bootloader.ld).
+ * 
+ * Enter DFU mode with a 10 s timeout instead of 60 s:
+ *   bl_mailbox_request(BL_MAILBOX_ACTION_DFU, 10000);
+ *   NVIC_SystemReset();
+ * 
+ * Restart without the full image check, after verifying the image:
+ *   const bl_services_t *bl = bl_services_get();
+ *   uint32_t crc = bl->crc32_update(bl->crc32_init(), BL_MAILBOX_IMAGE, BL_MAILBOX_IMAGE_SIZE());
+ *   if (bl->crc32_finalize(crc) == bl_mailbox_image_crc()) {
+ *       bl_mailbox_request(BL_MAILBOX_ACTION_SKIP_CHECK, bl_mailbox_image_crc());
+ *   }
+ *   NVIC_SystemReset();
+ * 
+ * Read boot information:
+ *   const volatile bl_mailbox_t *mb = bl_mailbox_get();
+ *   if (mb != NULL && mb->last_result == BL_MAILBOX_RESULT_TRUSTED) { ... }
+ * 
+ * Must match bootloader/inc/boot_mailbox.h.
+ */
+
+#define BL_MAILBOX_ADDR         0x20005FE0  /* Top of RAM, below the magic word */
+#define BL_MAILBOX_MAGIC        0xB0074B0C
+#define BL_MAILBOX_VERSION      1
+
+/* Requested actions (see bootloader/inc/boot_mailbox.h) */
+#define BL_MAILBOX_ACTION_NONE          0
+#define BL_MAILBOX_ACTION_DFU           1   /* arg = timeout ms, 0 = default (60 s) */
+#define BL_MAILBOX_ACTION_BOOT_SLOT     2   /* Not supported (single slot) */
+#define BL_MAILBOX_ACTION_SKIP_CHECK    3   /* arg = image CRC32 verified by the application */
+#define BL_MAILBOX_ACTION_DATA_UPDATE   4   /* arg = image CRC32, DFU for the data partition */
+
+#define BL_MAILBOX_TIMEOUT_NONE         0xFFFFFFFF  /* DFU without timeout */
+
+/* How the application was started (last_result) */
+#define BL_MAILBOX_RESULT_NONE          0
+#define BL_MAILBOX_RESULT_VALIDATED     1   /* Full image check */
+#define BL_MAILBOX_RESULT_TRUSTED       2   /* Image check skipped on request */
+#define BL_MAILBOX_RESULT_UNSUPPORTED   3   /* Action not supported, full image check */
+
+/* Image covered by the header CRC32 (vector table to end) */
+#define BL_MAILBOX_HEADER_ADDR  0x08004000
+#define BL_MAILBOX_IMAGE        ((const uint8_t *)(BL_MAILBOX_HEADER_ADDR + 0x100))
+#define BL_MAILBOX_IMAGE_SIZE() (*(const volatile uint32_t *)(BL_MAILBOX_HEADER_ADDR + 8))
+
+typedef struct {
+    uint32_t magic;         /* BL_MAILBOX_MAGIC */
+    uint16_t version;       /* BL_MAILBOX_VERSION */
+    uint16_t size;          /* sizeof(bl_mailbox_t) */
+    uint16_t action;        /* Requested action, cleared by the bootloader */
+    uint16_t last_action;   /* Action handled on the last boot */
+    uint32_t arg;           /* Action argument */
+    uint32_t boot_count;    /* Boots since the mailbox was initialized */
+    uint32_t last_result;   /* How the application was started */
+    uint32_t crc;           /* CRC32 of the fields above */
+} bl_mailbox_t;
+
+#define BL_MAILBOX  ((volatile bl_mailbox_t *)BL_MAILBOX_ADDR)
+
+/**
+ * @brief CRC32 of the mailbox fields before crc (bitwise, no table)
+ */
+static inline uint32_t bl_mailbox_crc(void)
+{
+    const volatile uint8_t *p = (const volatile uint8_t *)BL_MAILBOX_ADDR;
+    uint32_t crc = 0xFFFFFFFF;
+    
+    for (size_t i = 0; i < offsetof(bl_mailbox_t, crc); i++) {
+        crc ^= p[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320 : crc >> 1;
+        }
+    }
+    
+    return crc ^ 0xFFFFFFFF;
+}
+
+/**
+ * @brief Get the mailbox
+ * 
+ * @return Pointer to the mailbox, or NULL if the installed bootloader does
+ *         not provide one (or it was overwritten)
+ */
+static inline const volatile bl_mailbox_t *bl_mailbox_get(void)
+{
+    if (BL_MAILBOX->magic != BL_MAILBOX_MAGIC ||
+        BL_MAILBOX->version != BL_MAILBOX_VERSION ||
+        BL_MAILBOX->size != sizeof(bl_mailbox_t) ||
+        BL_MAILBOX->crc != bl_mailbox_crc()) {
+        return NULL;
+    }
+    
+    return BL_MAILBOX;
+}
+
+/**
+ * @brief Request an action for the next boot
+ * 
+ * Takes effect on the next reset (NVIC_SystemReset()). An invalid mailbox
+ * is initialized, with zero counters.
+ * 
+ * @param action Action (BL_MAILBOX_ACTION_*)
+ * @param arg Action argument
+ */
+static inline void bl_mailbox_request(uint16_t action, uint32_t arg)
+{
+    if (bl_mailbox_get() == NULL) {
+        BL_MAILBOX->magic = BL_MAILBOX_MAGIC;
+        BL_MAILBOX->version = BL_MAILBOX_VERSION;
+        BL_MAILBOX->size = sizeof(bl_mailbox_t);
+        BL_MAILBOX->last_action = BL_MAILBOX_ACTION_NONE;
+        BL_MAILBOX->boot_count = 0;
+        BL_MAILBOX->last_result = BL_MAILBOX_RESULT_NONE;
+    }
+    
+    BL_MAILBOX->action = action;
+    BL_MAILBOX->arg = arg;
+    BL_MAILBOX->crc = bl_mailbox_crc();
+}
+
+/**
+ * @brief CRC32 of the installed image, as signed into the header
+ * 
+ * Read from flash: the app_header constant in the application holds 0
+ * at compile time (signed after the build).
+ */
+static inline uint32_t bl_mailbox_image_crc(void)
+{
+    return *(const volatile uint32_t *)(BL_MAILBOX_HEADER_ADDR + 12);
+}
+
+#endif /* BOOTLOADER_MAILBOX_H */
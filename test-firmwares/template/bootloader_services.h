@@ -0,0 +1,117 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef BOOTLOADER_SERVICES_H
+#define BOOTLOADER_SERVICES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Bootloader service table (application side)
+ * 
+ * The bootloader exports its CRC32 and flash routines through a table of
+ * function pointers at a fixed address, so the application does not need
+ * to link its own copy.
+ * 
+ * Usage:
+ *   const bl_services_t *bl = bl_services_get();
+ *   if (bl != NULL) {
+ *       uint32_t crc = bl->crc32_init();
+ *       crc = bl->crc32_update(crc, data, len);
+ *       crc = bl->crc32_finalize(crc);
+ *   }
+ * 
+ * Flash erase/write entries only accept addresses inside the application
+ * region (0x08004000 and up), and return a negative error code otherwise.
+ * 
+ * Key/value store (persistent settings in the last two flash pages):
+ *   static kv_store_t kv;
+ *   if (bl != NULL && bl->kv_init(&kv) == 0) {
+ *       bl->kv_set(&kv, 0, (const uint8_t *)&setting, sizeof(setting));
+ *   }
+ * Keys 59 to 63 are reserved for the bootloader (kv_set/kv_delete fail).
+ * 
+ * Must match bootloader/inc/bootloader_services.h.
+ */
+
+#define BL_SERVICES_ADDR        0x08003F00  /* Last 256 bytes of bootloader (16KB on all targets) */
+#define BL_SERVICES_MAGIC       0xB007C0DE
+#define BL_SERVICES_VERSION     3
+
+#define KV_MAX_KEYS             64      /* Valid keys are 0 to KV_MAX_KEYS - 1 */
+#define KV_MAX_VALUE_LEN        256     /* Maximum value length in bytes */
+
+/* Key/value store context, treat as opaque */
+typedef struct {
+    uint32_t page_addr;
+    uint32_t sequence;
+    uint16_t write_offset;
+    uint16_t index[KV_MAX_KEYS];
+} kv_store_t;
+
+typedef struct {
+    uint32_t magic;          /* BL_SERVICES_MAGIC */
+    uint16_t version;        /* Table layout version */
+    uint16_t size;           /* Table size in bytes */
+    
+    /* Version 1 */
+    uint32_t (*get_version)(void);
+    uint32_t (*crc32_init)(void);
+    uint32_t (*crc32_update)(uint32_t crc, const uint8_t *data, size_t len);
+    uint32_t (*crc32_finalize)(uint32_t crc);
+    int (*flash_unlock)(void);
+    int (*flash_lock)(void);
+    int (*flash_erase_pages)(uint32_t addr, size_t len);
+    int (*flash_write)(uint32_t addr, const uint8_t *data, size_t len);
+    
+    /* Version 2 */
+    int (*kv_init)(kv_store_t *kv);
+    int (*kv_get)(const kv_store_t *kv, uint16_t key, uint8_t *buf, size_t buf_len, size_t *out_len);
+    int (*kv_set)(kv_store_t *kv, uint16_t key, const uint8_t *data, size_t len);
+    int (*kv_delete)(kv_store_t *kv, uint16_t key);
+    
+    /* Version 3 */
+    uint32_t (*crc32_combine)(uint32_t crc_a, uint32_t crc_b, size_t len_b);
+} bl_services_t;
+
+/**
+ * @brief Get the bootloader service table
+ * 
+ * @return Pointer to service table, or NULL if the installed bootloader
+ *         does not provide one (or provides an older layout)
+ */
+static inline const bl_services_t *bl_services_get(void)
+{
+    const bl_services_t *svc = (const bl_services_t *)BL_SERVICES_ADDR;
+    
+    if (svc->magic != BL_SERVICES_MAGIC || svc->version < BL_SERVICES_VERSION) {
+        return NULL;
+    }
+    
+    return svc;
+}
+
+#endif /* BOOTLOADER_SERVICES_H */
@@ -51,5 +51,19 @@ const app_header_t app_header = {
     .crc32 = 0,                      /* Signed by build script */
     .usb_vid = USB_VID,              /* USB Vendor ID for bootloader */
     .usb_pid = USB_PID,              /* USB Product ID for bootloader */
-    .reserved = {0, 0, 0}
+    .flags = APP_FLAGS,              /* Bootloader behavior options */
+    .header_version = APP_HEADER_VERSION,
+    .header_size = 0,                /* Signed by build script */
+    .header_crc = 0                  /* Signed by build script */
 };
+
+#ifdef APP_MIN_BL_VERSION
+/* TLV extension: minimum bootloader version */
+__attribute__((section(".app_header_tlv")))
+__attribute__((used))
+const app_tlv_u32_t app_tlv_min_bl_version = {
+    .type = APP_TLV_MIN_BL_VERSION,
+    .len = 4,
+    .value = APP_MIN_BL_VERSION
+};
+#endif
@@ -32,18 +32,30 @@ SOFTWARE.
 #include "ee_ws2812b_chibios_driver.h"
 
 
-#define PWM_HI (14)
-#define PWM_LO (6)
 #define BITS_PER_PIXEL (24)
-#define PWM_BUFFER_SIZE (BITS_PER_PIXEL + 1U) // Include 1 extra bit
-#define PWM_RESET_BUFFER_SIZE (40U) // 40 * 1.25us = 50us reset time
+#define STREAM_HALF_SIZE (EE_WS2812B_STREAM_LEDS * BITS_PER_PIXEL)
+#define STREAM_BUFFER_SIZE (2U * STREAM_HALF_SIZE)
+#define PWM_RESET_BUFFER_SIZE (40U) // 40 * 1.25us = 50us reset time (multiple of 4, LED data is written in words)
+// Reset, LEDs and 1 extra bit (one value per strip for each)
+#define PWM_FRAME_SIZE(n) ((PWM_RESET_BUFFER_SIZE + (uint32_t)(n) * BITS_PER_PIXEL + 1U) * EE_WS2812B_PARALLEL_STRIPS)
+#define PWM_BUFFER_SIZE PWM_FRAME_SIZE(EE_WS2812B_MAX_LEDS)
+#define TOTAL_LEDS ((uint32_t)num_leds * EE_WS2812B_PARALLEL_STRIPS)
+#define SPI_RESET_BUFFER_SIZE (20U) // 20 * 8 bits at 3MHz = 53us reset time
+#define SPI_BYTES_PER_LED (BITS_PER_PIXEL * 3U / 8U) // 3 SPI bits per bit
+#define SPI_FRAME_SIZE(n) (SPI_RESET_BUFFER_SIZE + (uint32_t)(n) * SPI_BYTES_PER_LED)
 #define PWM_DRIVER (&PWMD1)
 
 #define DMA_DRIVER (1U) // DMA1
 #define DMA_CHANNEL (1U) // Channel 1
 #define DMA_PRIORITY (0U) // Low priority
+#if EE_WS2812B_PARALLEL_STRIPS > 1
+#define DMA_REQUEST (25U) // DMAMUX request 25 for TIM1_UP (See RM0490 Reference Manual, Table 49)
+#define DMA_PERIPHERAL (&(TIM1->DMAR)) // DMA burst to CCR1..CCRn
+#define TIM_DCR_DBA_CCR1 (13U) // CCR1 offset (0x34) in words from TIM1 base
+#else
 #define DMA_REQUEST (22U) // DMAMUX request 22 for TIM1_CH3 (See RM0490 Reference Manual, Table 49)
 #define DMA_PERIPHERAL (&(TIM1->CCR3)) // DMA peripheral address
+#endif
 
 // Common DMA mode settings (with MINC)
 #define DMA_MODE_1 ( \
@@ -56,23 +68,71 @@ SOFTWARE.
     | STM32_DMA_CR_PL(0) /* Priority low */ \
 )
 
-// Common DMA mode settings (without MINC)
-#define DMA_MODE_2 ( \
-    STM32_DMA_CR_DIR_M2P /* Memory to peripheral */ \
-    | STM32_DMA_CR_PSIZE_HWORD /* Peripheral size 16 bits */ \
-    | STM32_DMA_CR_MSIZE_BYTE /* Memory size 8 bits */ \
-    | STM32_DMA_CR_TCIE /* Transfer complete interrupt enable */ \
-    | STM32_DMA_CR_TEIE /* Transfer error interrupt enable */ \
-    | STM32_DMA_CR_PL(0) /* Priority low */ \
+// Streaming DMA mode settings (circular, interrupt on each half)
+#define DMA_MODE_STREAM ( \
+    DMA_MODE_1 \
+    | STM32_DMA_CR_CIRC /* Circular mode */ \
+    | STM32_DMA_CR_HTIE /* Half transfer interrupt enable */ \
 )
 
 
-const uint8_t pwm_zero_buf = 0;
-uint8_t pwm_buf[PWM_BUFFER_SIZE] = {0}; // Ensure last value is untouched (always zero).
+#if EE_WS2812B_USE_STREAMING
+static uint8_t stream_buf[STREAM_BUFFER_SIZE] __attribute__((aligned(4))) = {0};
+static uint16_t stream_led = 0; // Next LED to encode
+static uint16_t stream_end = 0; // LEDs in the frame
+static bool stream_zero[2] = {true, true}; // Half holds only zero (reset) slots
+static volatile uint32_t stream_underruns = 0;
+static volatile uint32_t stream_min_margin = STREAM_HALF_SIZE;
+#elif EE_WS2812B_USE_SPI
+// Frame layout: reset period (zero, never written), LEDs (ends low)
+static uint8_t spi_buf[SPI_FRAME_SIZE(EE_WS2812B_MAX_LEDS)] = {0};
+#else
+// Frame layout: reset period (zero, never written), LEDs, zero after the last LED
+uint8_t pwm_buf[PWM_BUFFER_SIZE] __attribute__((aligned(4))) = {0};
+#endif
+#if !EE_WS2812B_USE_SPI
 static const stm32_dma_stream_t *dma_stream; // Global DMA stream pointer
-static volatile bool dma_ready = true;
+#endif
+static BSEMAPHORE_DECL(dma_done, false); // Taken while a frame is on the wire
+
+static uint8_t internal_framebuffer[EE_WS2812B_FRAMEBUFFER_SIZE(EE_WS2812B_MAX_LEDS * EE_WS2812B_PARALLEL_STRIPS)] = {0}; // GRB
+static uint8_t *framebuffer = internal_framebuffer;
+static uint16_t num_leds = 1U;
+
+static ee_ws2812b_encoder_t encoder = {
+    .msb_first = EE_WS2812B_MSB_FIRST,
+    .color_map = NULL // Applied to every byte when encoding
+};
 
 
+#if EE_WS2812B_USE_SPI
+static void spi_callback(SPIDriver *spip);
+
+static const SPIConfig spi_cfg = {
+    .end_cb     = spi_callback,
+    .cr1        = EE_WS2812B_SPI_CR1_BR,  // Master, mode 0, MSB first
+    .cr2        = SPI_CR2_DS_2 | SPI_CR2_DS_1 | SPI_CR2_DS_0  // 8-bit data
+};
+#elif EE_WS2812B_PARALLEL_STRIPS > 1
+#define STRIP_OUTPUT(k) ((EE_WS2812B_PARALLEL_STRIPS > (k)) ? PWM_OUTPUT_ACTIVE_HIGH : PWM_OUTPUT_DISABLED)
+
+static const PWMConfig pwm_cfg = {
+    .frequency  = 16000000,  // Counter clock frequency for PSC=2
+    .period     = 20,        // PWM period in ticks (ARR + 1)
+    .callback   = NULL,
+    .channels   = {
+        {.mode  = STRIP_OUTPUT(0), .callback = NULL},
+        {.mode  = STRIP_OUTPUT(1), .callback = NULL},
+        {.mode  = STRIP_OUTPUT(2), .callback = NULL},
+        {.mode  = STRIP_OUTPUT(3), .callback = NULL}
+    },
+    .cr2        = 0,
+#if STM32_ADVANCED_DMA
+    .bdtr       = 0,
+#endif
+    .dier       = STM32_TIM_DIER_UDE  // Enable DMA on update event (burst to all channels)
+};
+#else
 static const PWMConfig pwm_cfg = {
     .frequency  = 16000000,  // Counter clock frequency for PSC=2
     .period     = 20,        // PWM period in ticks (ARR + 1)
@@ -89,18 +149,86 @@ static const PWMConfig pwm_cfg = {
 #endif
     .dier       = STM32_TIM_DIER_CC3DE  // Enable DMA on CC3 event (TIMx_CH3 / PWM Channel 3)
 };
+#endif
+
+
+#if EE_WS2812B_USE_STREAMING
+/**
+ * @brief Encodes the next LEDs into one half of the streaming buffer.
+ * 
+ * Slots after the last LED are zero (output low), a half without LEDs is
+ * part of the reset period.
+ */
+static void stream_fill(uint32_t half) {
+    uint32_t leds = ee_ws2812b_encode_stream(&encoder, &stream_buf[half * STREAM_HALF_SIZE],
+                                             &framebuffer[stream_led * EE_WS2812B_BYTES_PER_LED],
+                                             stream_end - stream_led, EE_WS2812B_STREAM_LEDS);
+
+    stream_led += leds;
+    stream_zero[half] = (leds == 0);
+}
 
+static void dma_callback(void *p, uint32_t flags) {
+    (void)p;
 
-uint8_t led_reset(void);
+    if ((flags & (STM32_DMA_ISR_HTIF | STM32_DMA_ISR_TCIF)) == 0) {
+        return; // Handle errors if flags & STM32_DMA_ISR_TEIF, etc.
+    }
 
+    // Both halves completed before the interrupt was served
+    if ((flags & (STM32_DMA_ISR_HTIF | STM32_DMA_ISR_TCIF)) ==
+        (STM32_DMA_ISR_HTIF | STM32_DMA_ISR_TCIF)) {
+        stream_underruns++;
+    }
 
+    // Half that finished playing (TC = second half)
+    uint32_t half = (flags & STM32_DMA_ISR_TCIF) ? 1U : 0U;
+
+    // A zero half has played: reset period complete, stop the frame
+    if (stream_zero[half]) {
+        dmaStreamDisable(dma_stream);
+        chSysLockFromISR();
+        chBSemSignalI(&dma_done);
+        chSysUnlockFromISR();
+        return;
+    }
+
+    stream_fill(half);
+
+    // Slots left until the DMA reaches the refilled half
+    uint32_t remaining = dmaStreamGetTransactionSize(dma_stream);
+    uint32_t margin;
+    if (half == 0) {
+        margin = (remaining <= STREAM_HALF_SIZE) ? remaining : 0;
+    } else {
+        margin = (remaining > STREAM_HALF_SIZE) ? remaining - STREAM_HALF_SIZE : 0;
+    }
+
+    if (margin == 0) {
+        stream_underruns++;
+    }
+    if (margin < stream_min_margin) {
+        stream_min_margin = margin;
+    }
+}
+#elif EE_WS2812B_USE_SPI
+static void spi_callback(SPIDriver *spip) {
+    (void)spip;
+    chSysLockFromISR();
+    chBSemSignalI(&dma_done);
+    chSysUnlockFromISR();
+}
+#else
 static void dma_callback(void *p, uint32_t flags) {
     (void)p;
     if (flags & STM32_DMA_ISR_TCIF) {
-        dma_ready = true;
+        chSysLockFromISR();
+        chBSemSignalI(&dma_done);
+        chSysUnlockFromISR();
     }
     // Handle errors if flags & STM32_DMA_ISR_TEIF, etc.
 }
+#endif
 
 uint8_t ee_ws2812b_init_driver(void){
     ee_ws2812b_start_driver();
@@ -108,72 +236,211 @@ uint8_t ee_ws2812b_init_driver(void){
 }
 
 uint8_t ee_ws2812b_start_driver(void){
+#if EE_WS2812B_USE_SPI
+    spiStart(EE_WS2812B_SPI_DRIVER, &spi_cfg);
+    return 0;
+#else
     pwmStart(PWM_DRIVER, &pwm_cfg);
     dma_stream = dmaStreamAlloc(STM32_DMA_STREAM_ID(DMA_DRIVER, DMA_CHANNEL),
                                     DMA_PRIORITY, (stm32_dmaisr_t)dma_callback, NULL);
     dmaSetRequestSource(dma_stream, DMA_REQUEST);
     dmaStreamSetPeripheral(dma_stream, DMA_PERIPHERAL);
+#if EE_WS2812B_PARALLEL_STRIPS > 1
+    // Each update request transfers one value per strip to CCR1..CCRn
+    TIM1->DCR = STM32_TIM_DCR_DBL(EE_WS2812B_PARALLEL_STRIPS - 1U) | STM32_TIM_DCR_DBA(TIM_DCR_DBA_CCR1);
+#endif
     return 0;
+#endif
 }
 
 uint8_t ee_ws2812b_stop_driver(void){
+    ee_ws2812b_wait();
+#if EE_WS2812B_USE_SPI
+    spiStop(EE_WS2812B_SPI_DRIVER);
+#else
     dmaStreamDisable(dma_stream);
     dmaStreamFree(dma_stream); // NB! Illegal operation if already freed/released
     dma_stream = NULL;
     pwmStop(PWM_DRIVER);
+#endif
 
     return 0;
 }
 
-uint8_t ee_ws2812b_set_color_rgb(uint8_t r, uint8_t g, uint8_t b) {
-    for(int i = 0; i < 8; i++){
-        pwm_buf[i] = (g & (1 << i)) ? PWM_HI : PWM_LO;
-        pwm_buf[i + 8] = (r & (1 << i)) ? PWM_HI : PWM_LO;
-        pwm_buf[i + 16] = (b & (1 << i)) ? PWM_HI : PWM_LO;
+uint8_t ee_ws2812b_set_bit_order(bool msb_first) {
+    ee_ws2812b_wait(); // Do not change encoding during a frame
+
+    encoder.msb_first = msb_first;
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_set_framebuffer(uint8_t *fb, uint16_t leds) {
+    if (leds == 0 || leds > EE_WS2812B_MAX_LEDS) {
+        return 1;
     }
-    // pwm_buf[24] remains 0
+
+    ee_ws2812b_wait(); // Do not change the framebuffer during a frame
+
+    framebuffer = (fb != NULL) ? fb : internal_framebuffer;
+    num_leds = leds;
+
+    return 0;
+}
+
+uint16_t ee_ws2812b_get_num_leds(void) {
+    return num_leds;
+}
+
+uint8_t ee_ws2812b_set_pixel_rgb(uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index >= TOTAL_LEDS) {
+        return 1;
+    }
+
+    uint8_t *px = &framebuffer[index * EE_WS2812B_BYTES_PER_LED];
+    px[0] = g;
+    px[1] = r;
+    px[2] = b;
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_set_strip_pixel_rgb(uint8_t strip, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    if (strip >= EE_WS2812B_PARALLEL_STRIPS || index >= num_leds) {
+        return 1;
+    }
+
+    return ee_ws2812b_set_pixel_rgb((uint16_t)(strip * num_leds + index), r, g, b);
+}
+
+uint8_t ee_ws2812b_get_pixel_rgb(uint16_t index, uint8_t *r, uint8_t *g, uint8_t *b) {
+    if (index >= TOTAL_LEDS) {
+        return 1;
+    }
+
+    const uint8_t *px = &framebuffer[index * EE_WS2812B_BYTES_PER_LED];
+    *g = px[0];
+    *r = px[1];
+    *b = px[2];
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_fill_rgb(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint16_t i = 0; i < TOTAL_LEDS; i++) {
+        ee_ws2812b_set_pixel_rgb(i, r, g, b);
+    }
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_set_color_rgb(uint8_t r, uint8_t g, uint8_t b) {
+    return ee_ws2812b_set_pixel_rgb(0, r, g, b);
+}
+
+
+uint8_t ee_ws2812b_set_color_map(const uint8_t *map) {
+    ee_ws2812b_wait(); // Do not change encoding during a frame
+
+    encoder.color_map = map;
 
     return 0;
 }
 
-uint8_t ee_ws2812b_reset_render(void){
+uint8_t ee_ws2812b_render(void) {
+    return ee_ws2812b_render_first(num_leds);
+}
 
-    while (!dma_ready) {
-        chThdSleepMilliseconds(1);  // Wait for previous DMA to complete
+#if EE_WS2812B_USE_STREAMING
+uint8_t ee_ws2812b_render_first(uint16_t count) {
+    if (count == 0 || count > num_leds) {
+        return 1;
     }
-    dma_ready = false;
 
-    // Send reset by sending low signal for at least 50us
+    chBSemWait(&dma_done); // Wait for previous frame to complete
+
+    // Reset period is the trailing zero halves of the previous frame
+    stream_led = 0;
+    stream_end = count;
+    stream_fill(0);
+    stream_fill(1);
 
     dmaStreamDisable(dma_stream);
-    dmaStreamSetMode(dma_stream, DMA_MODE_2); // No MINC for repeated zero
-    dmaStreamSetMemory0(dma_stream, &pwm_zero_buf);
-    //dmaStreamSetMemory0(dma_stream, (uint8_t*)PWM_ZERO);
-    dmaStreamSetTransactionSize(dma_stream, PWM_RESET_BUFFER_SIZE);
+    dmaStreamSetMode(dma_stream, DMA_MODE_STREAM);
+    dmaStreamSetMemory0(dma_stream, stream_buf);
+    dmaStreamSetTransactionSize(dma_stream, STREAM_BUFFER_SIZE);
     dmaStreamEnable(dma_stream);
 
     return 0;
 }
 
-uint8_t ee_ws2812b_render(void) {
-    uint8_t status = 0;
+uint8_t ee_ws2812b_get_stream_stats(uint32_t *underruns, uint32_t *min_margin_slots) {
+    if (underruns != NULL) {
+        *underruns = stream_underruns;
+    }
+    if (min_margin_slots != NULL) {
+        *min_margin_slots = stream_min_margin;
+    }
+    return 0;
+}
+#elif EE_WS2812B_USE_SPI
+uint8_t ee_ws2812b_render_first(uint16_t count) {
+    if (count == 0 || count > num_leds) {
+        return 1;
+    }
+
+    chBSemWait(&dma_done); // Wait for previous frame to complete
 
-    // First reset the render
-    status = ee_ws2812b_reset_render();
+    // Previous frame is complete, the SPI buffer is free
+    ee_ws2812b_encode_spi(&encoder, &spi_buf[SPI_RESET_BUFFER_SIZE], framebuffer,
+                          (uint32_t)count * EE_WS2812B_BYTES_PER_LED);
 
-    while (!dma_ready) {
-        chThdSleepMilliseconds(1);  // Wait for previous DMA to complete
+    // Reset period and data in one transfer
+    spiStartSend(EE_WS2812B_SPI_DRIVER, SPI_FRAME_SIZE(count), spi_buf);
+
+    return 0;
+}
+#else
+uint8_t ee_ws2812b_render_first(uint16_t count) {
+    if (count == 0 || count > num_leds) {
+        return 1;
     }
-    dma_ready = false;
 
-    // Write the actual data
+    chBSemWait(&dma_done); // Wait for previous frame to complete
+
+    // Previous frame is complete, the PWM buffer is free
+#if EE_WS2812B_PARALLEL_STRIPS > 1
+    uint8_t *data = &pwm_buf[PWM_RESET_BUFFER_SIZE * EE_WS2812B_PARALLEL_STRIPS];
+    uint32_t strip_bytes = (uint32_t)num_leds * EE_WS2812B_BYTES_PER_LED;
+    for (uint32_t k = 0; k < EE_WS2812B_PARALLEL_STRIPS; k++) {
+        ee_ws2812b_encode_interleaved(&encoder, &data[k], &framebuffer[k * strip_bytes],
+                                      (uint32_t)count * EE_WS2812B_BYTES_PER_LED, EE_WS2812B_PARALLEL_STRIPS);
+    }
+    // Output low after the last bit
+    memset(&data[(uint32_t)count * BITS_PER_PIXEL * EE_WS2812B_PARALLEL_STRIPS], 0, EE_WS2812B_PARALLEL_STRIPS);
+#else
+    uint8_t *end = ee_ws2812b_encode_pwm(&encoder, &pwm_buf[PWM_RESET_BUFFER_SIZE], framebuffer,
+                                         (uint32_t)count * EE_WS2812B_BYTES_PER_LED);
+    *end = 0; // Output low after the last bit
+#endif
+
+    // Reset period and data in one transfer
     dmaStreamDisable(dma_stream);
     dmaStreamSetMode(dma_stream, DMA_MODE_1);
     dmaStreamSetMemory0(dma_stream, pwm_buf);
-    dmaStreamSetTransactionSize(dma_stream, PWM_BUFFER_SIZE);
+    dmaStreamSetTransactionSize(dma_stream, PWM_FRAME_SIZE(count));
     dmaStreamEnable(dma_stream);
 
-    return status;
+    return 0;
+}
+
+#endif
+
+uint8_t ee_ws2812b_wait(void) {
+    chBSemWait(&dma_done);
+    chBSemSignal(&dma_done);
+
+    return 0;
 }
 
 uint8_t ee_ws2812b_set_color_rgb_and_render(uint8_t r, uint8_t g, uint8_t b){
@@ -38,6 +38,8 @@ SOFTWARE.
 #include "ch.h"
 #include "hal.h"
 
+#include "ee_ws2812b_encode.h"
+
 #ifndef STM32C011xx
 #ifndef STM32C031xx
 #ifndef STM32C051xx
@@ -52,10 +54,43 @@ SOFTWARE.
 #endif
 #endif
 
-#if !HAL_USE_PWM
-#error "PWM not enabled in halconf.h"
+/**
+ * @brief Output backend: SPI instead of PWM (TIM1_CH3) and DMA.
+ * 
+ * The SPI backend sends each WS2812B bit as a 3-bit symbol (100 for 0, 110
+ * for 1) on MOSI, so the encoded frame takes 9 bytes per LED instead of 24,
+ * and TIM1 is left free. The MOSI pin must be set to its SPI alternate
+ * function by the application/board. Not available with
+ * EE_WS2812B_USE_STREAMING or parallel strips.
+ */
+#ifndef EE_WS2812B_USE_SPI
+#define EE_WS2812B_USE_SPI FALSE
+#endif
+
+/**
+ * @brief SPI driver used by the SPI backend.
+ */
+#ifndef EE_WS2812B_SPI_DRIVER
+#define EE_WS2812B_SPI_DRIVER (&SPID1)
+#endif
+
+/**
+ * @brief SPI baud rate prescaler (CR1 BR bits) of the SPI backend.
+ * 
+ * The default PCLK/16 gives 3MHz at 48MHz, i.e. 1.0 us per WS2812B bit with
+ * 0.33 us (0) and 0.67 us (1) high time.
+ */
+#ifndef EE_WS2812B_SPI_CR1_BR
+#define EE_WS2812B_SPI_CR1_BR (SPI_CR1_BR_1 | SPI_CR1_BR_0)
 #endif
 
+#if EE_WS2812B_USE_SPI
+
+#if !HAL_USE_SPI
+#error "SPI not enabled in halconf.h"
+#endif
+
+#else
 
 #if !HAL_USE_PWM
 #error "PWM not enabled in halconf.h"
@@ -65,11 +100,99 @@ SOFTWARE.
 #error "At least one PWM timer must be enabled in mcuconf.h"
 #endif
 
+#endif
+
 #if !STM32_DMA_REQUIRED
 #error "STM32_DMA_REQUIRED not enabled in mcuconf.h"
 #endif
 
 
+/**
+ * @brief Maximum number of LEDs in the strip.
+ * 
+ * Sizes the internal framebuffer (3 bytes per LED) and the PWM buffer
+ * (24 bytes per LED). Override from the Makefile (-DEE_WS2812B_MAX_LEDS=n).
+ */
+#ifndef EE_WS2812B_MAX_LEDS
+#define EE_WS2812B_MAX_LEDS (60U)
+#endif
+
+/**
+ * @brief Streaming mode (circular DMA).
+ * 
+ * When TRUE, the PWM values are encoded from the framebuffer into a small
+ * circular double buffer in the DMA half/complete interrupts, so RAM use
+ * does not depend on the strip length (3 bytes per LED framebuffer only).
+ * When FALSE, the whole strip is encoded before the transfer (24 bytes of
+ * RAM per LED).
+ */
+#ifndef EE_WS2812B_USE_STREAMING
+#define EE_WS2812B_USE_STREAMING FALSE
+#endif
+
+/**
+ * @brief LEDs per half of the streaming buffer (24 bytes each).
+ * 
+ * Each half plays for EE_WS2812B_STREAM_LEDS * 30 us, which is the time the
+ * interrupt has to encode the other half. Minimum 2 (a zero half is also
+ * the reset period of at least 50 us).
+ */
+#ifndef EE_WS2812B_STREAM_LEDS
+#define EE_WS2812B_STREAM_LEDS (4U)
+#endif
+
+#if EE_WS2812B_USE_STREAMING && (EE_WS2812B_STREAM_LEDS < 2)
+#error "EE_WS2812B_STREAM_LEDS must be at least 2"
+#endif
+
+/**
+ * @brief Number of strips driven in parallel (1 to 4).
+ * 
+ * 1 drives one strip on TIM1_CH3. 2 to 4 drive the strips on TIM1_CH1 to
+ * TIM1_CHn at the same time: on each timer update a DMA burst (TIM1 DCR/DMAR)
+ * writes the next value of every strip from an interleaved PWM buffer, so
+ * all strips are sent in the time of one. The pins of the extra channels
+ * must be set to their TIM1 alternate function by the application/board.
+ * Not available with EE_WS2812B_USE_STREAMING.
+ */
+#ifndef EE_WS2812B_PARALLEL_STRIPS
+#define EE_WS2812B_PARALLEL_STRIPS (1U)
+#endif
+
+#if (EE_WS2812B_PARALLEL_STRIPS < 1) || (EE_WS2812B_PARALLEL_STRIPS > 4)
+#error "EE_WS2812B_PARALLEL_STRIPS must be 1 to 4"
+#endif
+
+#if EE_WS2812B_USE_STREAMING && (EE_WS2812B_PARALLEL_STRIPS > 1)
+#error "EE_WS2812B_USE_STREAMING does not support parallel strips"
+#endif
+
+#if EE_WS2812B_USE_SPI && (EE_WS2812B_USE_STREAMING || (EE_WS2812B_PARALLEL_STRIPS > 1))
+#error "EE_WS2812B_USE_SPI does not support streaming or parallel strips"
+#endif
+
+/**
+ * @brief Default bit order of each color byte on the wire.
+ * 
+ * FALSE sends the LSB first (the original behaviour of this driver), TRUE
+ * sends the MSB first as in the WS2812B datasheet. Can be changed at run
+ * time with ee_ws2812b_set_bit_order().
+ */
+#ifndef EE_WS2812B_MSB_FIRST
+#define EE_WS2812B_MSB_FIRST FALSE
+#endif
+
+/**
+ * @brief Bytes per LED in the framebuffer (GRB order, as sent on the wire).
+ */
+#define EE_WS2812B_BYTES_PER_LED (3U)
+
+/**
+ * @brief Framebuffer size in bytes for n LEDs (all strips together).
+ */
+#define EE_WS2812B_FRAMEBUFFER_SIZE(n) ((n) * EE_WS2812B_BYTES_PER_LED)
+
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -97,19 +220,134 @@ uint8_t ee_ws2812b_start_driver(void);
 uint8_t ee_ws2812b_stop_driver(void);
 
 /**
- * @brief Sets the color (RGB) of the WS2812B LED.
+ * @brief Sets the bit order of each color byte on the wire.
+ * 
+ * Waits for an ongoing render to complete. The default is
+ * EE_WS2812B_MSB_FIRST.
+ * 
+ * @param msb_first true to send the MSB first, false to send the LSB first
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_set_bit_order(bool msb_first);
+
+/**
+ * @brief Sets the framebuffer of the WS2812B strip.
+ * 
+ * The default after init is the internal framebuffer with 1 LED. With
+ * parallel strips the framebuffer holds the strips one after another, and
+ * LED i of strip k has index k * num_leds + i. Waits for an ongoing render
+ * to complete.
+ * 
+ * @param framebuffer caller-provided buffer of
+ *                    EE_WS2812B_FRAMEBUFFER_SIZE(num_leds * EE_WS2812B_PARALLEL_STRIPS)
+ *                    bytes, or NULL for the internal framebuffer
+ * @param num_leds number of LEDs per strip (1 to EE_WS2812B_MAX_LEDS)
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_set_framebuffer(uint8_t *framebuffer, uint16_t num_leds);
+
+/**
+ * @brief Gets the number of LEDs in the strip.
+ * 
+ * @return uint16_t number of LEDs (per strip)
+ */
+uint16_t ee_ws2812b_get_num_leds(void);
+
+/**
+ * @brief Sets the color (RGB) of one LED in the framebuffer.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error (index out of range)
+ */
+uint8_t ee_ws2812b_set_pixel_rgb(uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Sets the color (RGB) of one LED of a parallel strip in the framebuffer.
+ * 
+ * @param strip strip number (0 to EE_WS2812B_PARALLEL_STRIPS - 1, TIM1_CH1 to CHn)
+ * @param index LED in the strip
+ * @return uint8_t status code, 0 success, nonzero on error (strip or index out of range)
+ */
+uint8_t ee_ws2812b_set_strip_pixel_rgb(uint8_t strip, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Gets the color (RGB) of one LED in the framebuffer.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error (index out of range)
+ */
+uint8_t ee_ws2812b_get_pixel_rgb(uint16_t index, uint8_t *r, uint8_t *g, uint8_t *b);
+
+/**
+ * @brief Sets the color (RGB) of all LEDs in the framebuffer.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_fill_rgb(uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Sets the color (RGB) of the WS2812B LED (first LED of the strip).
  * 
  * @return uint8_t status code, 0 success, nonzero on error
  */
 uint8_t ee_ws2812b_set_color_rgb(uint8_t r, uint8_t g, uint8_t b);
 
 /**
- * @brief Renders the WS2812B LED.
+ * @brief Renders the whole framebuffer to the WS2812B strip (one DMA transfer).
+ * 
+ * Waits only for the previous frame, and returns once the transfer is
+ * started. The framebuffer can be changed right away, except in streaming
+ * mode where it is read until the frame is complete (ee_ws2812b_wait()).
  * 
  * @return uint8_t status code, 0 success, nonzero on error
  */
 uint8_t ee_ws2812b_render(void);
 
+/**
+ * @brief Renders the first LEDs of the framebuffer (of each strip).
+ * 
+ * The LEDs after them are not sent and keep their last color. Same as
+ * ee_ws2812b_render() otherwise.
+ * 
+ * @param count number of LEDs to send (1 to ee_ws2812b_get_num_leds())
+ * @return uint8_t status code, 0 success, nonzero on error (count out of range)
+ */
+uint8_t ee_ws2812b_render_first(uint16_t count);
+
+/**
+ * @brief Sets a color map applied to every framebuffer byte when encoding.
+ * 
+ * Brightness, gamma or fade can be applied on the way out without changing
+ * the framebuffer. The table is read during encoding (during the whole
+ * frame in streaming mode) and must stay valid. Waits for an ongoing render
+ * to complete.
+ * 
+ * @param map table of 256 output values, or NULL for none (default)
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_set_color_map(const uint8_t *map);
+
+/**
+ * @brief Waits until the last rendered frame is completely sent.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_wait(void);
+
+#if EE_WS2812B_USE_STREAMING
+/**
+ * @brief Gets streaming interrupt statistics.
+ * 
+ * After each refill the interrupt checks how far the DMA is from the
+ * refilled half. The margin is in PWM slots of 1.25 us; a refill that
+ * finished after the DMA reached its half counts as an underrun
+ * (corrupted frame).
+ * 
+ * @param underruns number of late refills since start (may be NULL)
+ * @param min_margin_slots smallest margin seen since start (may be NULL)
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_get_stream_stats(uint32_t *underruns, uint32_t *min_margin_slots);
+#endif
+
 /**
  * @brief Sets the color (RGB) and renders the WS2812B LED.
  * 
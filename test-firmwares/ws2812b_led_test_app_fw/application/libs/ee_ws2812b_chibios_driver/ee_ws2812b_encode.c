@@ -0,0 +1,135 @@
+/*
+MIT License
+
+Copyright (c) 2025 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file ee_ws2812b_encode.c
+ * 
+ * @brief EngEmil WS2812B pulse encoders.
+ * 
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "ee_ws2812b_encode.h"
+
+
+#define BYTES_PER_LED (3U)
+#define BITS_PER_PIXEL (24U)
+#define PULSE(bit) ((uint32_t)((bit) ? EE_WS2812B_PWM_HI : EE_WS2812B_PWM_LO))
+// 4 PWM values of a nibble packed in a word (first slot in the low byte)
+#define PWM_LSB(n) (PULSE((n) & 1) | (PULSE((n) & 2) << 8) | (PULSE((n) & 4) << 16) | (PULSE((n) & 8) << 24))
+#define PWM_MSB(n) (PULSE((n) & 8) | (PULSE((n) & 4) << 8) | (PULSE((n) & 2) << 16) | (PULSE((n) & 1) << 24))
+
+#define SYMBOL(bit) ((uint16_t)((bit) ? 0x6U : 0x4U)) // 110 (one) or 100 (zero) on MOSI
+// 4 symbols of a nibble in 12 bits (first symbol in the high bits, SPI is MSB first)
+#define SPI_LSB(n) ((SYMBOL((n) & 1) << 9) | (SYMBOL((n) & 2) << 6) | (SYMBOL((n) & 4) << 3) | SYMBOL((n) & 8))
+#define SPI_MSB(n) ((SYMBOL((n) & 8) << 9) | (SYMBOL((n) & 4) << 6) | (SYMBOL((n) & 2) << 3) | SYMBOL((n) & 1))
+
+#define NIBBLES(m) { \
+    m(0),  m(1),  m(2),  m(3),  m(4),  m(5),  m(6),  m(7), \
+    m(8),  m(9),  m(10), m(11), m(12), m(13), m(14), m(15) \
+}
+
+// Nibble lookup tables, one per bit order (LSB first: low nibble first)
+static const uint32_t pwm_lsb[16] = NIBBLES(PWM_LSB);
+static const uint32_t pwm_msb[16] = NIBBLES(PWM_MSB);
+static const uint16_t spi_lsb[16] = NIBBLES(SPI_LSB);
+static const uint16_t spi_msb[16] = NIBBLES(SPI_MSB);
+
+
+uint8_t *ee_ws2812b_encode_pwm(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                               const uint8_t *src, uint32_t len) {
+    const uint32_t *lut = enc->msb_first ? pwm_msb : pwm_lsb;
+    const uint8_t *map = enc->color_map;
+    uint32_t first = enc->msb_first ? 4U : 0U; // Nibble sent first
+    uint32_t second = 4U - first;
+    uint32_t *dst = (uint32_t *)out;
+
+    for (uint32_t i = 0; i < len; i++) {
+        uint32_t c = src[i];
+        if (map != NULL) {
+            c = map[c];
+        }
+        *dst++ = lut[(c >> first) & 0x0FU];
+        *dst++ = lut[(c >> second) & 0x0FU];
+    }
+    return (uint8_t *)dst;
+}
+
+uint32_t ee_ws2812b_encode_stream(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                                  const uint8_t *src, uint32_t leds, uint32_t half_leds) {
+    if (leds > half_leds) {
+        leds = half_leds;
+    }
+
+    out = ee_ws2812b_encode_pwm(enc, out, src, leds * BYTES_PER_LED);
+    memset(out, 0, (half_leds - leds) * BITS_PER_PIXEL);
+
+    return leds;
+}
+
+void ee_ws2812b_encode_interleaved(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                                   const uint8_t *src, uint32_t len, uint32_t stride) {
+    const uint32_t *lut = enc->msb_first ? pwm_msb : pwm_lsb;
+    const uint8_t *map = enc->color_map;
+    uint32_t first = enc->msb_first ? 4U : 0U;
+    uint32_t second = 4U - first;
+
+    for (uint32_t i = 0; i < len; i++) {
+        uint32_t c = src[i];
+        if (map != NULL) {
+            c = map[c];
+        }
+        uint32_t w = lut[(c >> first) & 0x0FU];
+        for (int n = 0; n < 2; n++) {
+            out[0] = (uint8_t)w;
+            out[stride] = (uint8_t)(w >> 8);
+            out[2 * stride] = (uint8_t)(w >> 16);
+            out[3 * stride] = (uint8_t)(w >> 24);
+            out += 4 * stride;
+            w = lut[(c >> second) & 0x0FU];
+        }
+    }
+}
+
+uint8_t *ee_ws2812b_encode_spi(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                               const uint8_t *src, uint32_t len) {
+    const uint16_t *lut = enc->msb_first ? spi_msb : spi_lsb;
+    const uint8_t *map = enc->color_map;
+    uint32_t first = enc->msb_first ? 4U : 0U;
+    uint32_t second = 4U - first;
+
+    for (uint32_t i = 0; i < len; i++) {
+        uint32_t c = src[i];
+        if (map != NULL) {
+            c = map[c];
+        }
+        uint32_t w = ((uint32_t)lut[(c >> first) & 0x0FU] << 12) | lut[(c >> second) & 0x0FU];
+        *out++ = (uint8_t)(w >> 16);
+        *out++ = (uint8_t)(w >> 8);
+        *out++ = (uint8_t)w;
+    }
+    return out;
+}
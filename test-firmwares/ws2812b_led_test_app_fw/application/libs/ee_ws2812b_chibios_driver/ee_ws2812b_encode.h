@@ -0,0 +1,111 @@
+/*
+MIT License
+
+Copyright (c) 2025 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file ee_ws2812b_encode.h
+ * 
+ * @brief EngEmil WS2812B pulse encoders.
+ * 
+ * Expands framebuffer bytes into PWM duty values (one byte per bit) or SPI
+ * symbols (3 bits per bit) with two 16-entry nibble tables per bit order.
+ * Independent of ChibiOS, so the encoders can be tested and benchmarked on
+ * a host (see test/).
+ */
+
+#ifndef _EE_WS2812B_ENCODE_
+#define _EE_WS2812B_ENCODE_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/**
+ * @brief PWM duty values of a 1 and a 0 bit (ticks of the 20 tick period).
+ */
+#define EE_WS2812B_PWM_HI (14U)
+#define EE_WS2812B_PWM_LO (6U)
+
+/**
+ * @brief Encoder settings.
+ */
+typedef struct {
+    bool msb_first;           // Send the MSB of each byte first
+    const uint8_t *color_map; // 256 entry table applied to every byte, or NULL
+} ee_ws2812b_encoder_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Encodes bytes into PWM duty values (8 values per byte).
+ * 
+ * Two table lookups per byte, each writing 4 values as one word. The output
+ * must be 4-byte aligned.
+ * 
+ * @return pointer after the last written value
+ */
+uint8_t *ee_ws2812b_encode_pwm(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                               const uint8_t *src, uint32_t len);
+
+/**
+ * @brief Encodes the next LEDs into one half of a streaming buffer.
+ * 
+ * Encodes up to half_leds LEDs (GRB) into PWM duty values and zeroes the
+ * slots after them (output low), so that the half always holds
+ * half_leds * 24 values. A half without LEDs is part of the reset period.
+ * 
+ * @param out half of the streaming buffer (4-byte aligned)
+ * @param leds LEDs left to send from src
+ * @param half_leds LEDs per half
+ * @return number of LEDs encoded, 0 when the half is all zero
+ */
+uint32_t ee_ws2812b_encode_stream(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                                  const uint8_t *src, uint32_t leds, uint32_t half_leds);
+
+/**
+ * @brief Encodes bytes into PWM duty values at every stride-th position.
+ * 
+ * Used for parallel strips, where the values of the strips are interleaved.
+ */
+void ee_ws2812b_encode_interleaved(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                                   const uint8_t *src, uint32_t len, uint32_t stride);
+
+/**
+ * @brief Encodes bytes into SPI symbols (3 bytes per byte, sent MSB first).
+ * 
+ * A 1 bit is the symbol 110, a 0 bit is 100.
+ * 
+ * @return pointer after the last written byte
+ */
+uint8_t *ee_ws2812b_encode_spi(const ee_ws2812b_encoder_t *enc, uint8_t *out,
+                               const uint8_t *src, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _EE_WS2812B_ENCODE_ */
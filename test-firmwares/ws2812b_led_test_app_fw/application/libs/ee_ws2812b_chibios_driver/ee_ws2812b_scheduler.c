@@ -0,0 +1,236 @@
+/*
+MIT License
+
+Copyright (c) 2025 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file ee_ws2812b_scheduler.c
+ * 
+ * @brief EngEmil WS2812B frame scheduler.
+ * 
+ */
+
+#include "ee_ws2812b_scheduler.h"
+
+
+#define LEVEL_FULL (255U << 8) // Fade level in 8.8 fixed point
+
+// Gamma 2.2: round(255 * (i / 255)^2.2)
+static const uint8_t gamma_table[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255
+};
+
+static uint8_t sched_map[256]; // Brightness, fade and gamma for the driver encoder
+static bool map_changed = true;
+
+static uint8_t brightness = 255U;
+static bool gamma_enabled = false;
+static uint32_t fade_level = LEVEL_FULL; // 8.8 fixed point
+static int32_t fade_step = 0; // Per frame, 8.8 fixed point
+static uint32_t fade_target = LEVEL_FULL;
+static uint32_t fade_frames = 0; // Frames left of the fade
+
+static uint16_t dirty_end = 0; // LEDs (of each strip) to send, 0 when nothing changed
+static sysinterval_t frame_period;
+static systime_t frame_start;
+static ee_ws2812b_sched_stats_t sched_stats;
+
+
+/**
+ * @brief Builds the color map from brightness, fade level and gamma.
+ */
+static void build_color_map(void) {
+    // Combined scale 0..256 (x * (scale + 1) >> 8 keeps 255 at full scale)
+    uint32_t scale = ((uint32_t)brightness * (fade_level >> 8) + 127U) / 255U + 1U;
+
+    for (uint32_t i = 0; i < 256U; i++) {
+        uint32_t v = (i * scale) >> 8;
+        sched_map[i] = gamma_enabled ? gamma_table[v] : (uint8_t)v;
+    }
+}
+
+uint8_t ee_ws2812b_sched_init(uint32_t period_ms) {
+    if (period_ms == 0) {
+        return 1;
+    }
+
+    frame_period = TIME_MS2I(period_ms);
+    frame_start = chVTGetSystemTimeX();
+
+    brightness = 255U;
+    gamma_enabled = false;
+    fade_level = LEVEL_FULL;
+    fade_target = LEVEL_FULL;
+    fade_step = 0;
+    fade_frames = 0;
+    map_changed = true;
+
+    dirty_end = ee_ws2812b_get_num_leds();
+    memset(&sched_stats, 0, sizeof(sched_stats));
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_sched_frame(void) {
+    systime_t now = chVTGetSystemTimeX();
+    systime_t next = chTimeAddX(frame_start, frame_period);
+    bool pending = (dirty_end != 0) || (fade_frames != 0) || map_changed;
+
+    if (chTimeIsInRangeX(now, frame_start, next)) {
+        chThdSleepUntilWindowed(now, next);
+        frame_start = next;
+    } else {
+        // Late: count the full periods that passed while changes were pending
+        if (pending) {
+            sched_stats.dropped += chTimeDiffX(next, now) / frame_period;
+        }
+        frame_start = now;
+    }
+
+    if (fade_frames != 0) {
+        fade_frames--;
+        fade_level = (fade_frames == 0) ? fade_target : (uint32_t)((int32_t)fade_level + fade_step);
+        map_changed = true;
+    }
+
+    if (map_changed) {
+        ee_ws2812b_wait(); // Map is read while encoding
+        build_color_map();
+        ee_ws2812b_set_color_map(sched_map);
+        map_changed = false;
+        dirty_end = ee_ws2812b_get_num_leds();
+    }
+
+    if (dirty_end == 0) {
+        sched_stats.idle++;
+        return 0;
+    }
+
+    systime_t t0 = chVTGetSystemTimeX();
+    uint8_t status = ee_ws2812b_render_first(dirty_end);
+    uint32_t frame_us = TIME_I2US(chTimeDiffX(t0, chVTGetSystemTimeX()));
+
+    dirty_end = 0;
+    sched_stats.frames++;
+    sched_stats.last_frame_us = frame_us;
+    if (frame_us > sched_stats.max_frame_us) {
+        sched_stats.max_frame_us = frame_us;
+    }
+
+    return status;
+}
+
+uint8_t ee_ws2812b_sched_mark_dirty(uint16_t first, uint16_t count) {
+    uint32_t leds = ee_ws2812b_get_num_leds();
+
+    if (count == 0 || (uint32_t)first + count > leds * EE_WS2812B_PARALLEL_STRIPS) {
+        return 1;
+    }
+
+    // Frames are sent from the first LED of each strip, only the end matters
+    uint32_t end = (first % leds) + count;
+    if (end > leds) {
+        end = leds; // Range continues on the next strip
+    }
+    if (end > dirty_end) {
+        dirty_end = (uint16_t)end;
+    }
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_sched_set_pixel_rgb(uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    uint8_t status = ee_ws2812b_set_pixel_rgb(index, r, g, b);
+
+    if (status == 0) {
+        status = ee_ws2812b_sched_mark_dirty(index, 1);
+    }
+
+    return status;
+}
+
+uint8_t ee_ws2812b_sched_fill_rgb(uint8_t r, uint8_t g, uint8_t b) {
+    ee_ws2812b_fill_rgb(r, g, b);
+    dirty_end = ee_ws2812b_get_num_leds();
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_sched_set_brightness(uint8_t level) {
+    if (level != brightness) {
+        brightness = level;
+        map_changed = true;
+    }
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_sched_set_gamma(bool enable) {
+    if (enable != gamma_enabled) {
+        gamma_enabled = enable;
+        map_changed = true;
+    }
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_sched_fade_to(uint8_t level, uint32_t duration_ms) {
+    uint32_t frames = TIME_MS2I(duration_ms) / frame_period;
+
+    fade_target = (uint32_t)level << 8;
+
+    if (frames == 0) {
+        fade_level = fade_target;
+        fade_frames = 0;
+        map_changed = true;
+    } else {
+        fade_step = ((int32_t)fade_target - (int32_t)fade_level) / (int32_t)frames;
+        fade_frames = frames;
+    }
+
+    return 0;
+}
+
+uint8_t ee_ws2812b_sched_get_stats(ee_ws2812b_sched_stats_t *stats) {
+    if (stats == NULL) {
+        return 1;
+    }
+
+    *stats = sched_stats;
+
+    return 0;
+}
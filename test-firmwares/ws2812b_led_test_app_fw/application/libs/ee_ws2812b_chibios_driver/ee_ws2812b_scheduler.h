@@ -0,0 +1,146 @@
+/*
+MIT License
+
+Copyright (c) 2025 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+/**
+ * @file ee_ws2812b_scheduler.h
+ * 
+ * @brief EngEmil WS2812B frame scheduler.
+ * 
+ * Renders the framebuffer at most once per frame period, and only when
+ * pixels were marked dirty or the brightness, gamma or fade changed. The
+ * color correction is applied by the driver while encoding, through a 256
+ * entry color map (see ee_ws2812b_set_color_map()), so the framebuffer keeps
+ * the original colors.
+ * 
+ * All functions must be called from the same thread.
+ */
+
+#ifndef _EE_WS2812B_SCHEDULER_
+#define _EE_WS2812B_SCHEDULER_
+
+#include "ee_ws2812b_chibios_driver.h"
+
+
+/**
+ * @brief Scheduler statistics.
+ */
+typedef struct {
+    uint32_t frames;        // Rendered frames
+    uint32_t idle;          // Frame periods without changes (not rendered)
+    uint32_t dropped;       // Frame periods missed while changes were pending
+    uint32_t last_frame_us; // Time spent in the last render call (encode and start)
+    uint32_t max_frame_us;  // Longest render call
+} ee_ws2812b_sched_stats_t;
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/**
+ * @brief Initializes the scheduler (driver must be initialized).
+ * 
+ * Marks the whole strip dirty and resets brightness, gamma, fade and
+ * statistics.
+ * 
+ * @param period_ms frame period in milliseconds
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_sched_init(uint32_t period_ms);
+
+/**
+ * @brief Waits for the next frame period and renders if anything changed.
+ * 
+ * Call once per iteration of the animation loop. If called after the frame
+ * period has passed it renders right away, and full periods missed while
+ * changes were pending are counted as dropped.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_sched_frame(void);
+
+/**
+ * @brief Marks framebuffer LEDs as changed.
+ * 
+ * @param first first LED (framebuffer index as in ee_ws2812b_set_pixel_rgb())
+ * @param count number of LEDs
+ * @return uint8_t status code, 0 success, nonzero on error (out of range)
+ */
+uint8_t ee_ws2812b_sched_mark_dirty(uint16_t first, uint16_t count);
+
+/**
+ * @brief Sets the color (RGB) of one LED and marks it dirty.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error (index out of range)
+ */
+uint8_t ee_ws2812b_sched_set_pixel_rgb(uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Sets the color (RGB) of all LEDs and marks them dirty.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_sched_fill_rgb(uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Sets the global brightness (255 = full).
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_sched_set_brightness(uint8_t brightness);
+
+/**
+ * @brief Enables gamma correction (2.2) of the output.
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_sched_set_gamma(bool enable);
+
+/**
+ * @brief Fades the output level linearly to a target.
+ * 
+ * The level scales the brightness (255 = no fade) and is stepped once per
+ * frame period.
+ * 
+ * @param level target level (0 = off, 255 = full)
+ * @param duration_ms fade duration in milliseconds (0 = immediately)
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_sched_fade_to(uint8_t level, uint32_t duration_ms);
+
+/**
+ * @brief Gets the scheduler statistics.
+ * 
+ * Times have the resolution of the system tick (CH_CFG_ST_FREQUENCY).
+ * 
+ * @return uint8_t status code, 0 success, nonzero on error
+ */
+uint8_t ee_ws2812b_sched_get_stats(ee_ws2812b_sched_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _EE_WS2812B_SCHEDULER_ */
@@ -0,0 +1,148 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file bench_ee_ws2812b_encode.c
+ * @brief WS2812B encoder benchmark (host timings, make bench)
+ * 
+ * Times the nibble table encoders against the per-bit loop they replaced,
+ * the refill of one half of the streaming buffer, and gives the frame time
+ * of a strip (wire time from the frame length plus the encode time).
+ * The numbers are for the host the benchmark runs on, the Cortex-M0+ has to
+ * be measured on the target (see the driver README).
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "ee_ws2812b_encode.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LEDS        300
+#define DATA_LEN    (LEDS * 3)
+#define RESET_SLOTS 40      // PWM reset period of the driver (50 us)
+#define SLOT_US     1.25    // One WS2812B bit (PWM period)
+#define RUNS        1000
+#define BATCHES     25
+
+static uint8_t data[DATA_LEN];
+static uint8_t out[DATA_LEN * 8] __attribute__((aligned(4)));
+
+/** @brief Per-bit encoder (three masked tests per bit, as before the tables) */
+__attribute__((noinline))
+static uint8_t *loop_pwm(uint8_t *dst, const uint8_t *src, uint32_t len, bool msb_first)
+{
+    for (uint32_t i = 0; i < len; i += 3) {
+        uint8_t g = src[i], r = src[i + 1], b = src[i + 2];
+        for (int n = 0; n < 8; n++) {
+            int bit = msb_first ? 7 - n : n;
+            dst[n] = (g & (1 << bit)) ? EE_WS2812B_PWM_HI : EE_WS2812B_PWM_LO;
+            dst[n + 8] = (r & (1 << bit)) ? EE_WS2812B_PWM_HI : EE_WS2812B_PWM_LO;
+            dst[n + 16] = (b & (1 << bit)) ? EE_WS2812B_PWM_HI : EE_WS2812B_PWM_LO;
+        }
+        dst += 24;
+    }
+    return dst;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/** @brief Best time of one call over BATCHES batches of RUNS calls, in us */
+#define BENCH(result, call) do { \
+    double best = 1e30; \
+    for (int b = 0; b < BATCHES; b++) { \
+        double t0 = now_ns(); \
+        for (int r = 0; r < RUNS; r++) { \
+            call; \
+            __asm__ volatile("" ::: "memory"); \
+        } \
+        double t = (now_ns() - t0) / RUNS; \
+        if (t < best) { \
+            best = t; \
+        } \
+    } \
+    (result) = best / 1000.0; \
+} while (0)
+
+int main(void)
+{
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    printf("Encoding %u LEDs (%u bytes), best of %u x %u runs\n\n",
+           LEDS, DATA_LEN, BATCHES, RUNS);
+    printf("%-10s %12s %12s %8s\n", "Bit order", "Loop (us)", "Tables (us)", "Speedup");
+
+    for (int msb_first = 0; msb_first < 2; msb_first++) {
+        ee_ws2812b_encoder_t enc = {.msb_first = msb_first, .color_map = NULL};
+        double t_loop, t_lut;
+
+        BENCH(t_loop, loop_pwm(out, data, DATA_LEN, msb_first));
+        BENCH(t_lut, ee_ws2812b_encode_pwm(&enc, out, data, DATA_LEN));
+        printf("%-10s %12.2f %12.2f %7.1fx\n", msb_first ? "MSB first" : "LSB first",
+               t_loop, t_lut, t_loop / t_lut);
+    }
+
+    ee_ws2812b_encoder_t enc = {.msb_first = false, .color_map = NULL};
+    uint8_t spi[DATA_LEN * 3];
+    double t_spi;
+
+    BENCH(t_spi, ee_ws2812b_encode_spi(&enc, spi, data, DATA_LEN));
+    printf("%-10s %12s %12.2f\n", "SPI", "", t_spi);
+
+    // Streaming mode: one refill from the DMA interrupt, against the time
+    // the other half plays (30 us per LED)
+    printf("\n%-10s %12s %12s\n", "Half LEDs", "Refill (us)", "Budget (us)");
+    for (uint32_t half_leds = 2; half_leds <= 8; half_leds *= 2) {
+        double t_fill;
+
+        BENCH(t_fill, ee_ws2812b_encode_stream(&enc, out, data, LEDS, half_leds));
+        printf("%-10u %12.3f %12u\n", half_leds, t_fill, half_leds * 30U);
+    }
+
+    // Full-buffer mode: one DMA transfer of the reset period, the LEDs and
+    // one low value, each 1.25 us on the wire
+    static const uint32_t strips[] = {1, 60, 150, 300};
+    printf("\n%-6s %10s %12s %12s %10s\n", "LEDs", "Wire (ms)", "Encode (us)", "Rate (Hz)", "RAM (B)");
+    for (size_t i = 0; i < sizeof(strips) / sizeof(strips[0]); i++) {
+        uint32_t leds = strips[i];
+        uint32_t slots = RESET_SLOTS + (uint32_t)(ee_ws2812b_encode_pwm(&enc, out, data, leds * 3) - out) + 1;
+        double wire_us = slots * SLOT_US;
+        double t_enc;
+
+        BENCH(t_enc, ee_ws2812b_encode_pwm(&enc, out, data, leds * 3));
+        printf("%-6u %10.2f %12.2f %12.0f %10u\n", leds, wire_us / 1000.0, t_enc,
+               1e6 / (wire_us + t_enc), slots);
+    }
+
+    return 0;
+}
@@ -0,0 +1,265 @@
+/*
+MIT License
+
+Copyright (c) 2026 EngEmil
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+/**
+ * @file test_ee_ws2812b_encode.c
+ * @brief WS2812B encoder tests (nibble tables against a per-bit reference)
+ */
+
+#include "unity.h"
+#include "ee_ws2812b_encode.h"
+#include <string.h>
+
+#define LEDS        300
+#define DATA_LEN    (LEDS * 3)
+#define STRIDE      3
+
+static uint8_t data[DATA_LEN];
+static uint8_t out[DATA_LEN * 8 + 8] __attribute__((aligned(4)));
+static uint8_t ref[DATA_LEN * 8 + 8];
+static uint8_t map[256];
+
+/** @brief Value of bit n (in wire order) of a byte */
+static int wire_bit(uint8_t c, int n, bool msb_first)
+{
+    return (c >> (msb_first ? 7 - n : n)) & 1;
+}
+
+/** @brief Per-bit PWM encoder, as the driver did before the tables */
+static void ref_pwm(uint8_t *dst, const uint8_t *src, size_t len, size_t stride, bool msb_first)
+{
+    for (size_t i = 0; i < len; i++) {
+        for (int n = 0; n < 8; n++) {
+            dst[(i * 8 + n) * stride] = wire_bit(src[i], n, msb_first) ? EE_WS2812B_PWM_HI : EE_WS2812B_PWM_LO;
+        }
+    }
+}
+
+/** @brief Per-bit SPI encoder (3 bits per bit, MSB first on MOSI) */
+static void ref_spi(uint8_t *dst, const uint8_t *src, size_t len, bool msb_first)
+{
+    memset(dst, 0, len * 3);
+    for (size_t i = 0; i < len; i++) {
+        for (int n = 0; n < 8; n++) {
+            size_t pos = (i * 8 + n) * 3; // First SPI bit of the symbol
+            dst[pos / 8] |= (uint8_t)(0x80 >> (pos % 8)); // Always high
+            if (wire_bit(src[i], n, msb_first)) {
+                dst[(pos + 1) / 8] |= (uint8_t)(0x80 >> ((pos + 1) % 8));
+            }
+        }
+    }
+}
+
+void setUp(void)
+{
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+    for (size_t i = 0; i < 256; i++) {
+        data[i] = (uint8_t)i; // Every byte value
+        map[i] = (uint8_t)(255 - i);
+    }
+    memset(out, 0xAA, sizeof(out));
+    memset(ref, 0xAA, sizeof(ref));
+}
+
+void tearDown(void)
+{
+}
+
+static void check_pwm(bool msb_first, const uint8_t *color_map)
+{
+    ee_ws2812b_encoder_t enc = {.msb_first = msb_first, .color_map = color_map};
+    uint8_t mapped[DATA_LEN];
+
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        mapped[i] = color_map ? color_map[data[i]] : data[i];
+    }
+    ref_pwm(ref, mapped, DATA_LEN, 1, msb_first);
+
+    TEST_ASSERT_EQUAL_PTR(out + DATA_LEN * 8, ee_ws2812b_encode_pwm(&enc, out, data, DATA_LEN));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, out, DATA_LEN * 8);
+    TEST_ASSERT_EQUAL_HEX8(0xAA, out[DATA_LEN * 8]); // Nothing written after the end
+}
+
+void test_pwm_lsb_first(void)
+{
+    check_pwm(false, NULL);
+}
+
+void test_pwm_msb_first(void)
+{
+    check_pwm(true, NULL);
+}
+
+void test_pwm_color_map(void)
+{
+    check_pwm(false, map);
+    check_pwm(true, map);
+}
+
+void test_pwm_first_led(void)
+{
+    // GRB of one LED, as the single LED functions render it
+    const uint8_t grb[3] = {0x01, 0x80, 0xF0};
+    const uint8_t expected[24] = {
+        14, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 14,
+        6, 6, 6, 6, 14, 14, 14, 14
+    };
+    ee_ws2812b_encoder_t enc = {.msb_first = false, .color_map = NULL};
+
+    ee_ws2812b_encode_pwm(&enc, out, grb, 3);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, 24);
+}
+
+void test_interleaved(void)
+{
+    for (int msb_first = 0; msb_first < 2; msb_first++) {
+        ee_ws2812b_encoder_t enc = {.msb_first = msb_first, .color_map = NULL};
+        size_t len = sizeof(out) / (8 * STRIDE);
+
+        memset(out, 0xAA, sizeof(out));
+        memset(ref, 0xAA, sizeof(ref));
+        ref_pwm(ref + 1, data, len, STRIDE, msb_first);
+        ee_ws2812b_encode_interleaved(&enc, out + 1, data, len, STRIDE);
+        // Values of the other strips are left alone
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, out, len * 8 * STRIDE);
+    }
+}
+
+void test_spi(void)
+{
+    for (int msb_first = 0; msb_first < 2; msb_first++) {
+        ee_ws2812b_encoder_t enc = {.msb_first = msb_first, .color_map = NULL};
+
+        ref_spi(ref, data, DATA_LEN, msb_first);
+        TEST_ASSERT_EQUAL_PTR(out + DATA_LEN * 3, ee_ws2812b_encode_spi(&enc, out, data, DATA_LEN));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, out, DATA_LEN * 3);
+    }
+}
+
+void test_spi_color_map(void)
+{
+    ee_ws2812b_encoder_t enc = {.msb_first = true, .color_map = map};
+    uint8_t mapped[DATA_LEN];
+
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        mapped[i] = map[data[i]];
+    }
+    ref_spi(ref, mapped, DATA_LEN, true);
+    ee_ws2812b_encode_spi(&enc, out, data, DATA_LEN);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, out, DATA_LEN * 3);
+}
+
+/**
+ * @brief Sends a frame through a model of the streaming DMA
+ * 
+ * Two halves of half_leds LEDs, refilled as the driver does: both halves
+ * before the start, then the half that finished playing from its interrupt,
+ * and stop after a zero half has played. Everything the DMA reads is
+ * appended to wire, including the half playing when it is stopped.
+ * 
+ * @return number of values on the wire
+ */
+static size_t stream_frame(const uint8_t *fb, uint32_t count, uint32_t half_leds, uint8_t *wire)
+{
+    static uint8_t buf[2][8 * 24] __attribute__((aligned(4)));
+    ee_ws2812b_encoder_t enc = {.msb_first = false, .color_map = NULL};
+    uint32_t led = 0;
+    bool zero[2];
+    size_t len = 0;
+
+    for (int h = 0; h < 2; h++) {
+        uint32_t n = ee_ws2812b_encode_stream(&enc, buf[h], &fb[led * 3], count - led, half_leds);
+        led += n;
+        zero[h] = (n == 0);
+    }
+
+    for (int h = 0; ; h ^= 1) {
+        memcpy(&wire[len], buf[h], half_leds * 24);
+        len += half_leds * 24;
+        if (zero[h]) {
+            memcpy(&wire[len], buf[h ^ 1], half_leds * 24); // Stopped while playing
+            return len + half_leds * 24;
+        }
+        uint32_t n = ee_ws2812b_encode_stream(&enc, buf[h], &fb[led * 3], count - led, half_leds);
+        led += n;
+        zero[h] = (n == 0);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(count, led);
+    }
+}
+
+void test_stream(void)
+{
+    ee_ws2812b_encoder_t enc = {.msb_first = false, .color_map = NULL};
+
+    for (uint32_t half_leds = 2; half_leds <= 8; half_leds *= 2) {
+        for (uint32_t count = 1; count <= 40; count++) {
+            size_t len = stream_frame(data, count, half_leds, out);
+            size_t data_len = count * 24;
+
+            ee_ws2812b_encode_pwm(&enc, ref, data, count * 3);
+            TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, out, data_len);
+            // Output low after the last LED, for at least the 50 us reset (40 slots)
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(len - half_leds * 24, data_len + 40);
+            for (size_t i = data_len; i < len; i++) {
+                TEST_ASSERT_EQUAL_UINT8(0, out[i]);
+            }
+        }
+    }
+}
+
+void test_stream_partial_half(void)
+{
+    ee_ws2812b_encoder_t enc = {.msb_first = false, .color_map = NULL};
+
+    memset(out, 0xAA, 4 * 24);
+    TEST_ASSERT_EQUAL_UINT32(1, ee_ws2812b_encode_stream(&enc, out, data, 1, 4));
+    ee_ws2812b_encode_pwm(&enc, ref, data, 3);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ref, out, 24);
+    for (size_t i = 24; i < 4 * 24; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, out[i]);
+    }
+    TEST_ASSERT_EQUAL_HEX8(0xAA, out[4 * 24]);
+
+    TEST_ASSERT_EQUAL_UINT32(0, ee_ws2812b_encode_stream(&enc, out, data, 0, 4));
+    TEST_ASSERT_EQUAL_UINT8(0, out[0]);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_pwm_lsb_first);
+    RUN_TEST(test_pwm_msb_first);
+    RUN_TEST(test_pwm_color_map);
+    RUN_TEST(test_pwm_first_led);
+    RUN_TEST(test_interleaved);
+    RUN_TEST(test_spi);
+    RUN_TEST(test_spi_color_map);
+    RUN_TEST(test_stream);
+    RUN_TEST(test_stream_partial_half);
+    return UNITY_END();
+}